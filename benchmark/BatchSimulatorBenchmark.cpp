@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/BatchSimulator.h"
+
+// Measures how the batch simulator scales with the number of worker threads.
+// The same batch of games played by the greedy policy is run with 1, 2, 4,
+// ... threads up to the number of hardware threads. For each number of
+// threads, the benchmark reports the duration, the ticks per second, the
+// speedup over a single thread and the parallel efficiency, i.e. the speedup
+// divided by the number of threads. Since every game is seeded on its own,
+// all runs play the very same games, which is checked as well.
+//
+// Usage: BatchSimulatorBenchmark [<number_games> [<max_number_threads>]]
+
+namespace {
+
+constexpr std::size_t kDefaultNumberGames{2000};
+
+std::vector<int> GetThreadCounts(int max_number_threads) {
+    std::vector<int> thread_counts;
+    for (int number_threads{1}; number_threads < max_number_threads;
+         number_threads *= 2) {
+        thread_counts.push_back(number_threads);
+    }
+    thread_counts.push_back(max_number_threads);
+    return thread_counts;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    SimulationSettings settings;
+    settings.number_games = kDefaultNumberGames;
+    int max_number_threads{
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+    if (argc >= 2) {
+        settings.number_games = std::stoul(argv[1]);
+    }
+    if (argc >= 3) {
+        max_number_threads = std::max(1, std::stoi(argv[2]));
+    }
+    std::cout << "grid: 20x10, games: " << settings.number_games
+              << ", max pieces per game: " << settings.max_number_pieces
+              << ", hardware threads: " << std::thread::hardware_concurrency()
+              << std::endl;
+    std::cout << std::setw(10) << "threads" << std::setw(12) << "seconds"
+              << std::setw(14) << "ticks/s" << std::setw(10) << "speedup"
+              << std::setw(12) << "efficiency" << std::endl;
+
+    double single_thread_duration{0.0};
+    SimulationStatistics single_thread_statistics;
+    for (int number_threads : GetThreadCounts(max_number_threads)) {
+        settings.number_threads = number_threads;
+        BatchSimulator simulator{
+            settings, []() { return std::make_unique<GreedyInputPolicy>(); }};
+        SimulationReport report{simulator.Run()};
+        const SimulationStatistics &statistics{report.statistics};
+        if (number_threads == 1) {
+            single_thread_duration = report.duration_seconds;
+            single_thread_statistics = statistics;
+        } else if (statistics.number_ticks !=
+                       single_thread_statistics.number_ticks ||
+                   statistics.total_score !=
+                       single_thread_statistics.total_score) {
+            std::cerr << "the games played by " << number_threads
+                      << " threads differ from the ones of a single thread"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // runs too short to be measured, e.g. of no games at all, have
+        // neither a rate nor a speedup
+        std::cout << std::setw(10) << number_threads << std::fixed
+                  << std::setprecision(3) << std::setw(12)
+                  << report.duration_seconds;
+        std::optional<double> ticks_per_second{ComputeRatePerSecond(
+            static_cast<double>(statistics.number_ticks),
+            report.duration_seconds)};
+        if (ticks_per_second &&
+            single_thread_duration >= kMinRateDurationSeconds) {
+            double speedup{single_thread_duration / report.duration_seconds};
+            std::cout << std::scientific << std::setw(14) << *ticks_per_second
+                      << std::fixed << std::setprecision(2) << std::setw(10)
+                      << speedup << std::setw(12) << speedup / number_threads;
+        } else {
+            std::cout << std::setw(14) << "n/a" << std::setw(10) << "n/a"
+                      << std::setw(12) << "n/a";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
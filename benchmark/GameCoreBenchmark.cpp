@@ -0,0 +1,66 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "../src/GameCore.h"
+
+// Measures how many ticks per second the headless game core processes. The
+// game is fed a fixed cycle of inputs which moves, rotates and drops the
+// pieces across the whole grid, and a new game is started whenever the game
+// is over. For each gravity mode, the benchmark reports the number of ticks,
+// locked pieces and cleared lines per second.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr long kNumberTicks{20000000};
+
+constexpr std::array<GameInput, 16> kInputCycle{
+    GameInput::move_left,  GameInput::move_down,  GameInput::rotate,
+    GameInput::move_left,  GameInput::move_down,  GameInput::none,
+    GameInput::move_left,  GameInput::move_down,  GameInput::hard_drop,
+    GameInput::move_right, GameInput::move_down,  GameInput::move_right,
+    GameInput::rotate,     GameInput::move_right, GameInput::move_down,
+    GameInput::hard_drop};
+
+void Measure(const char *name, GravityMode gravity_mode) {
+    GameCore game_core(20, 10, gravity_mode, PieceRandomizer{1});
+    long number_locked_pieces{0};
+    long number_cleared_lines{0};
+    long number_games{1};
+
+    auto start{Clock::now()};
+    for (long tick{0}; tick < kNumberTicks; ++tick) {
+        StepResult result{
+            game_core.Step(kInputCycle[tick % kInputCycle.size()])};
+        number_locked_pieces += result.is_piece_locked ? 1 : 0;
+        number_cleared_lines += result.number_cleared_lines;
+        if (result.is_game_over) {
+            game_core.StartNewGame();
+            ++number_games;
+        }
+    }
+    std::chrono::duration<double> duration{Clock::now() - start};
+
+    std::cout << std::setw(10) << name << std::scientific
+              << std::setprecision(3) << std::setw(14)
+              << kNumberTicks / duration.count() << std::setw(14)
+              << number_locked_pieces / duration.count() << std::setw(14)
+              << number_cleared_lines / duration.count() << std::defaultfloat
+              << std::setw(10) << number_games << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "grid: 20x10, ticks: " << kNumberTicks << std::endl;
+    std::cout << std::setw(10) << "gravity" << std::setw(14) << "ticks/s"
+              << std::setw(14) << "locks/s" << std::setw(14) << "lines/s"
+              << std::setw(10) << "games" << std::endl;
+    Measure("line", GravityMode::line);
+    Measure("cascade", GravityMode::cascade);
+    return EXIT_SUCCESS;
+}
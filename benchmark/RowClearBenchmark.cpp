@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/GridLogic.h"
+
+// Measures how the throughput of clearing rows develops with a growing board
+// width. Every board is filled such that every other row is fully occupied
+// and the remaining rows lack a single cell. For each width, the benchmark
+// reports
+//  - the number of rows per second scanned for being full by each row scan
+//    implementation supported by the CPU and
+//  - the number of rows per second removed by collapsing the grid.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kNumberRows{200};
+constexpr int kNumberRepetitions{200};
+
+std::vector<std::uint8_t> CreatePackedBits(const GridLogic &grid_logic) {
+    std::vector<std::uint8_t> buffer(grid_logic.GetPackedBitsSize());
+    int number_columns{grid_logic.GetNumberOfColumns()};
+    std::size_t bit_index{0};
+    for (int row{0}; row < kNumberRows; ++row) {
+        for (int column{0}; column < number_columns; ++column) {
+            bool is_gap{row % 2 == 1 && column == row % number_columns};
+            if (!is_gap) {
+                buffer[bit_index / 8] |=
+                    static_cast<std::uint8_t>(1U << (bit_index % 8));
+            }
+            ++bit_index;
+        }
+    }
+    return buffer;
+}
+
+const char *GetName(RowScanImplementation implementation) {
+    switch (implementation) {
+        case RowScanImplementation::avx2:
+            return "avx2";
+        case RowScanImplementation::sse41:
+            return "sse4.1";
+        default:
+            return "scalar";
+    }
+}
+
+double MeasureRowScans(const GridLogic &grid_logic) {
+    long number_full_rows{0};
+    auto start{Clock::now()};
+    for (int repetition{0}; repetition < kNumberRepetitions; ++repetition) {
+        for (int row{0}; row < kNumberRows; ++row) {
+            number_full_rows += grid_logic.IsRowFull(row) ? 1 : 0;
+        }
+    }
+    std::chrono::duration<double> duration{Clock::now() - start};
+    if (number_full_rows != kNumberRepetitions * kNumberRows / 2) {
+        std::cerr << "unexpected number of full rows" << std::endl;
+    }
+    return kNumberRepetitions * kNumberRows / duration.count();
+}
+
+double MeasureCollapse(GridLogic &grid_logic,
+                       const std::vector<std::uint8_t> &packed_bits) {
+    long number_cleared_rows{0};
+    std::chrono::duration<double> duration{0};
+    for (int repetition{0}; repetition < kNumberRepetitions; ++repetition) {
+        grid_logic.ImportPackedBits(packed_bits.data(), packed_bits.size());
+        number_cleared_rows += static_cast<long>(
+            grid_logic.GetIndexesOfFullyOccupiedRows().size());
+        auto start{Clock::now()};
+        grid_logic.CollapseEntirelyOccupiedRows();
+        duration += Clock::now() - start;
+    }
+    return number_cleared_rows / duration.count();
+}
+
+}  // namespace
+
+int main() {
+    const RowScanImplementation implementations[]{
+        RowScanImplementation::scalar, RowScanImplementation::sse41,
+        RowScanImplementation::avx2};
+    RowScanImplementation default_implementation{GetRowScanImplementation()};
+
+    std::cout << "rows: " << kNumberRows
+              << ", repetitions: " << kNumberRepetitions << std::endl;
+    std::cout << std::setw(8) << "columns";
+    for (auto implementation : implementations) {
+        if (IsRowScanImplementationSupported(implementation)) {
+            std::cout << std::setw(18)
+                      << std::string{"scan "} + GetName(implementation);
+        }
+    }
+    std::cout << std::setw(18) << "collapse" << "   [rows/s]" << std::endl;
+
+    for (int number_columns : {10, 64, 128, 256, 512, 1024, 4096}) {
+        GridLogic grid_logic(kNumberRows, number_columns);
+        std::vector<std::uint8_t> packed_bits{CreatePackedBits(grid_logic)};
+        grid_logic.ImportPackedBits(packed_bits.data(), packed_bits.size());
+
+        std::cout << std::setw(8) << number_columns << std::scientific
+                  << std::setprecision(3);
+        for (auto implementation : implementations) {
+            if (SetRowScanImplementation(implementation)) {
+                std::cout << std::setw(18) << MeasureRowScans(grid_logic);
+            }
+        }
+        SetRowScanImplementation(default_implementation);
+        std::cout << std::setw(18) << MeasureCollapse(grid_logic, packed_bits)
+                  << std::defaultfloat << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
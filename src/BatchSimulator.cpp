@@ -0,0 +1,119 @@
+#include "BatchSimulator.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "WorkStealingPool.h"
+
+namespace {
+
+// state of a worker thread, aligned to not share a cache line with the state
+// of another worker
+struct alignas(64) WorkerState {
+    std::unique_ptr<GameCore> game_core;
+    std::unique_ptr<IInputPolicy> policy;
+    SimulationStatistics statistics;
+};
+
+}  // namespace
+
+void SimulationStatistics::Add(const GameResult &result) {
+    ++number_games;
+    number_games_over += result.is_game_over ? 1 : 0;
+    number_pieces += result.number_pieces;
+    number_ticks += result.number_ticks;
+    number_cleared_lines += result.number_cleared_lines;
+    total_score += result.score;
+    max_score = std::max(max_score, result.score);
+}
+
+void SimulationStatistics::Merge(const SimulationStatistics &other) {
+    number_games += other.number_games;
+    number_games_over += other.number_games_over;
+    number_pieces += other.number_pieces;
+    number_ticks += other.number_ticks;
+    number_cleared_lines += other.number_cleared_lines;
+    total_score += other.total_score;
+    max_score = std::max(max_score, other.max_score);
+}
+
+BatchSimulator::BatchSimulator(const SimulationSettings &settings,
+                               InputPolicyFactory policy_factory)
+    : m_settings{settings}, m_policy_factory{std::move(policy_factory)} {}
+
+SimulationReport BatchSimulator::Run() {
+    SimulationReport report;
+    report.number_threads = std::max(m_settings.number_threads, 1);
+    report.game_results.resize(m_settings.number_games);
+
+    WorkStealingPool pool{report.number_threads};
+    std::vector<WorkerState> workers(report.number_threads);
+    for (WorkerState &worker : workers) {
+        worker.game_core = std::make_unique<GameCore>(
+            m_settings.number_grid_rows, m_settings.number_grid_columns,
+            m_settings.gravity_mode,
+            PieceRandomizer{m_settings.seed, m_settings.randomizer_policy},
+            m_settings.preview_length);
+        worker.policy = m_policy_factory();
+    }
+
+    auto start{std::chrono::steady_clock::now()};
+    pool.Run(m_settings.number_games,
+             [this, &workers, &report](std::size_t game_index,
+                                       int worker_index) {
+                 WorkerState &worker{workers[worker_index]};
+                 GameResult result{PlayGame(
+                     m_settings, m_settings.seed + game_index,
+                     *worker.game_core, *worker.policy)};
+                 worker.statistics.Add(result);
+                 report.game_results[game_index] = result;
+             });
+    std::chrono::duration<double> duration{std::chrono::steady_clock::now() -
+                                           start};
+    report.duration_seconds = duration.count();
+
+    for (const WorkerState &worker : workers) {
+        report.statistics.Merge(worker.statistics);
+    }
+    return report;
+}
+
+GameResult BatchSimulator::PlayGame(const SimulationSettings &settings,
+                                    std::uint64_t seed, GameCore &game_core,
+                                    IInputPolicy &policy) {
+    game_core.StartNewGame(PieceRandomizer{seed, settings.randomizer_policy});
+    policy.Reset(seed);
+
+    GameResult result;
+    result.seed = seed;
+    auto step = [&game_core, &result](GameInput input) {
+        StepResult step_result{game_core.Step(input)};
+        ++result.number_ticks;
+        result.number_pieces += step_result.is_piece_locked ? 1 : 0;
+    };
+    int number_inputs_since_gravity_step{0};
+    while (!game_core.IsGameOver() &&
+           result.number_pieces < settings.max_number_pieces) {
+        step(policy.GetNextInput(game_core));
+        if (settings.inputs_per_gravity_step > 0 &&
+            ++number_inputs_since_gravity_step ==
+                settings.inputs_per_gravity_step) {
+            number_inputs_since_gravity_step = 0;
+            if (!game_core.IsGameOver()) {
+                step(GameInput::move_down);
+            }
+        }
+    }
+    result.score = game_core.GetScore();
+    result.number_cleared_lines = game_core.GetNumberOfClearedLines();
+    result.is_game_over = game_core.IsGameOver();
+    return result;
+}
+
+std::optional<double> ComputeRatePerSecond(double number_events,
+                                           double duration_seconds) {
+    if (number_events <= 0.0 || duration_seconds < kMinRateDurationSeconds) {
+        return std::nullopt;
+    }
+    return number_events / duration_seconds;
+}
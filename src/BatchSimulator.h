@@ -0,0 +1,116 @@
+#ifndef BATCH_SIMULATOR_H_
+#define BATCH_SIMULATOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "GameCore.h"
+#include "InputPolicy.h"
+#include "PieceRandomizer.h"
+
+/// Settings shared by all games of a batch
+struct SimulationSettings {
+    /// number of games being played
+    std::size_t number_games{1000};
+    /// seed of the first game, game n is played with the seed + n
+    std::uint64_t seed{1};
+    int number_grid_rows{20};
+    int number_grid_columns{10};
+    GravityMode gravity_mode{GravityMode::line};
+    RandomizerPolicy randomizer_policy{RandomizerPolicy::uniform};
+    /// number of tetrominoes waiting behind the active one, see PieceQueue
+    int preview_length{PieceQueue::kDefaultLength};
+    /// a game ends after this number of pieces even if it is not over
+    long max_number_pieces{1000};
+    /// number of inputs after which the active piece falls by one row like
+    /// by the gravity timer of the game, 0 disables the gravity
+    int inputs_per_gravity_step{10};
+    /// number of worker threads
+    int number_threads{1};
+};
+
+/// Outcome of a single game
+struct GameResult {
+    std::uint64_t seed{0};
+    int score{0};
+    int number_cleared_lines{0};
+    long number_pieces{0};
+    long number_ticks{0};
+    /// false if the game has been ended by
+    /// SimulationSettings::max_number_pieces
+    bool is_game_over{false};
+};
+
+/// Outcome of a number of games added up
+struct SimulationStatistics {
+    std::size_t number_games{0};
+    std::size_t number_games_over{0};
+    long long number_pieces{0};
+    long long number_ticks{0};
+    long long number_cleared_lines{0};
+    long long total_score{0};
+    int max_score{0};
+
+    /// Adds the outcome of a single game.
+    void Add(const GameResult &result);
+
+    /// Adds the outcome of other games.
+    void Merge(const SimulationStatistics &other);
+};
+
+/// Outcome of a batch of games
+struct SimulationReport {
+    SimulationStatistics statistics;
+    /// results in the order of the game seeds
+    std::vector<GameResult> game_results;
+    int number_threads{1};
+    double duration_seconds{0.0};
+};
+
+/// shortest duration from which a rate is derived, see ComputeRatePerSecond()
+constexpr double kMinRateDurationSeconds{1e-3};
+
+/// Retrieves how many events happened per second.
+/// \param number_events:    number of events, e.g. games or ticks
+/// \param duration_seconds: duration in which the events happened
+/// \return nothing if no events happened or the duration is shorter than
+///         kMinRateDurationSeconds, so the rate would be meaningless
+std::optional<double> ComputeRatePerSecond(double number_events,
+                                           double duration_seconds);
+
+/// Creates a policy playing the games of one worker thread
+using InputPolicyFactory = std::function<std::unique_ptr<IInputPolicy>()>;
+
+/// The BatchSimulator class plays many independent games without a display
+/// on a WorkStealingPool. Every worker thread owns a GameCore, an input
+/// policy and its statistics, which are merged once all games are over, so
+/// the workers share nothing but the pool while playing. Since every game is
+/// seeded on its own, the results do not depend on the number of threads.
+class BatchSimulator {
+   public:
+    /// \param settings:       settings of the batch
+    /// \param policy_factory: creates one input policy per worker thread
+    BatchSimulator(const SimulationSettings &settings,
+                   InputPolicyFactory policy_factory);
+
+    /// Plays all games of the batch.
+    SimulationReport Run();
+
+    /// Plays a single game.
+    /// \param settings:  settings of the batch the game belongs to
+    /// \param seed:      seed of the game
+    /// \param game_core: game core being reset for the game
+    /// \param policy:    player of the game
+    static GameResult PlayGame(const SimulationSettings &settings,
+                               std::uint64_t seed, GameCore &game_core,
+                               IInputPolicy &policy);
+
+   private:
+    SimulationSettings m_settings;
+    InputPolicyFactory m_policy_factory;
+};
+
+#endif /* BATCH_SIMULATOR_H_ */
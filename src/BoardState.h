@@ -0,0 +1,78 @@
+#ifndef BOARD_STATE_H_
+#define BOARD_STATE_H_
+
+#include <array>
+#include <type_traits>
+
+#include "RowScan.h"
+
+/// Fixed-size snapshot of the occupancy of a logical grid. As opposed to
+/// GridLogic, the snapshot does not own any heap memory and is trivially
+/// copyable, so it can live on the stack and be copied with a plain memcpy,
+/// e.g. when a search clones the board for every branch. The bit layout
+/// equals the one of GridLogic: each row consists of kNumberWordsPerRow
+/// words, and the cell (r/c) is occupied when bit c % 64 of word c / 64 of
+/// row r is set. Use GridLogic::SaveState() and GridLogic::RestoreState() to
+/// convert between both. Value-initialize a snapshot, e.g. StandardBoardState
+/// state{}, to start with an empty board.
+template <int NumberRows, int NumberColumns>
+struct BoardState {
+    static_assert(NumberRows > 0 && NumberColumns > 0,
+                  "a board needs at least one row and one column");
+
+    static constexpr int kNumberRows{NumberRows};
+    static constexpr int kNumberColumns{NumberColumns};
+    static constexpr int kNumberWordsPerRow{
+        (NumberColumns + kColumnsPerRowWord - 1) / kColumnsPerRowWord};
+
+    /// Determines whether the specified cell is occupied. The indexes are
+    /// expected to be within the board bounds.
+    bool IsCellOccupied(int row_index, int column_index) const {
+        return ((GetWord(row_index, column_index) >>
+                 (column_index % kColumnsPerRowWord)) &
+                1U) != 0;
+    }
+
+    /// Marks the specified cell as occupied
+    void OccupyCell(int row_index, int column_index) {
+        GetWord(row_index, column_index) |= RowBitsType{1}
+                                            << (column_index %
+                                                kColumnsPerRowWord);
+    }
+
+    /// Marks the specified cell as free
+    void FreeCell(int row_index, int column_index) {
+        GetWord(row_index, column_index) &=
+            ~(RowBitsType{1} << (column_index % kColumnsPerRowWord));
+    }
+
+    bool operator==(const BoardState &other) const {
+        return words == other.words;
+    }
+    bool operator!=(const BoardState &other) const {
+        return !(*this == other);
+    }
+
+    /// bitmask words of all rows from top to bottom
+    std::array<RowBitsType, NumberRows * kNumberWordsPerRow> words;
+
+   private:
+    RowBitsType &GetWord(int row_index, int column_index) {
+        return words[row_index * kNumberWordsPerRow +
+                     column_index / kColumnsPerRowWord];
+    }
+    const RowBitsType &GetWord(int row_index, int column_index) const {
+        return words[row_index * kNumberWordsPerRow +
+                     column_index / kColumnsPerRowWord];
+    }
+};
+
+/// Snapshot of the standard playfield with 20 rows and 10 columns
+using StandardBoardState = BoardState<20, 10>;
+
+static_assert(std::is_trivially_copyable<StandardBoardState>::value,
+              "board snapshots must be copyable with memcpy");
+static_assert(sizeof(StandardBoardState) == 20 * sizeof(RowBitsType),
+              "the standard board snapshot is one word per row");
+
+#endif /* BOARD_STATE_H_ */
@@ -0,0 +1,118 @@
+#ifndef BYTE_STREAM_H_
+#define BYTE_STREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// The ByteWriter class appends values to a buffer in the little endian
+/// layout shared by the binary replay and game state formats.
+class ByteWriter {
+   public:
+    /// \param buffer: buffer the values are appended to
+    explicit ByteWriter(std::vector<std::uint8_t> &buffer) : m_buffer{buffer} {}
+
+    /// Appends the lower bytes of a value.
+    /// \param value:        value being appended
+    /// \param number_bytes: number of bytes being appended, at most 8
+    void PutFixed(std::uint64_t value, int number_bytes) {
+        for (int index{0}; index < number_bytes; ++index) {
+            m_buffer.push_back(static_cast<std::uint8_t>(value >> (8 * index)));
+        }
+    }
+
+    /// Appends a value in 7 bits per byte, the highest bit of a byte telling
+    /// whether another byte follows, so small values take a single byte.
+    void PutVarint(std::uint64_t value) {
+        while (value >= 0x80) {
+            m_buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_buffer.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    /// Appends a number of zero bytes and retrieves where they start, e.g.
+    /// for a block being filled in place afterwards. The pointer is
+    /// invalidated by the next append.
+    std::uint8_t *PutBytes(std::size_t number_bytes) {
+        std::size_t offset{m_buffer.size()};
+        m_buffer.resize(offset + number_bytes);
+        return m_buffer.data() + offset;
+    }
+
+   private:
+    std::vector<std::uint8_t> &m_buffer;
+};
+
+/// The ByteReader class reads values written by a ByteWriter and remembers
+/// whether it ran out of data on the way, so callers may check once after
+/// reading a number of values.
+class ByteReader {
+   public:
+    /// \param data: data being read
+    /// \param size: number of bytes of the data
+    ByteReader(const std::uint8_t *data, std::size_t size)
+        : m_data{data}, m_end{data + size} {}
+
+    /// Reads a value written by ByteWriter::PutFixed().
+    /// \return the value, 0 if the data ran out
+    std::uint64_t GetFixed(int number_bytes) {
+        if (m_end - m_data < number_bytes) {
+            m_is_valid = false;
+            return 0;
+        }
+        std::uint64_t value{0};
+        for (int index{0}; index < number_bytes; ++index) {
+            value |= static_cast<std::uint64_t>(*m_data++) << (8 * index);
+        }
+        return value;
+    }
+
+    /// Reads a value written by ByteWriter::PutVarint().
+    /// \return the value, 0 if the data ran out or the value is too long
+    std::uint64_t GetVarint() {
+        std::uint64_t value{0};
+        for (int shift{0}; shift < 64; shift += 7) {
+            if (m_data == m_end) {
+                break;
+            }
+            std::uint8_t byte{*m_data++};
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        m_is_valid = false;
+        return 0;
+    }
+
+    /// Skips a block of bytes and retrieves where it starts.
+    /// \return the start of the block, nullptr if the data ran out
+    const std::uint8_t *GetBytes(std::size_t number_bytes) {
+        if (GetRemainingSize() < number_bytes) {
+            m_is_valid = false;
+            return nullptr;
+        }
+        const std::uint8_t *bytes{m_data};
+        m_data += number_bytes;
+        return bytes;
+    }
+
+    /// Determines whether all values so far have been read completely.
+    bool IsValid() const { return m_is_valid; }
+
+    /// Determines whether all data has been read.
+    bool IsAtEnd() const { return m_data == m_end; }
+
+    /// Retrieves the number of bytes not read yet.
+    std::size_t GetRemainingSize() const {
+        return static_cast<std::size_t>(m_end - m_data);
+    }
+
+   private:
+    const std::uint8_t *m_data;
+    const std::uint8_t *m_end;
+    bool m_is_valid{true};
+};
+
+#endif /* BYTE_STREAM_H_ */
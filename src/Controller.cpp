@@ -1,12 +1,39 @@
 #include "Controller.h"
 
 #include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
 #include <thread>
 
 #include "GridGraphic.h"
 
-Controller::Controller(sf::RenderWindow& window, sf::Font& font)
-    : m_game{Game(m_number_rows, m_number_columns, window, font)} {
+Controller::Controller(sf::RenderWindow& window, sf::Font& font,
+                       int number_rows, int number_columns,
+                       std::string replay_path, std::string state_path)
+    : m_number_rows{number_rows},
+      m_number_columns{number_columns},
+      m_replay_path{std::move(replay_path)},
+      m_state_path{std::move(state_path)},
+      m_game{Game(m_number_rows, m_number_columns, window, font)} {
+    // Resume the saved game if there is one
+    if (!m_state_path.empty()) {
+        std::ifstream file{m_state_path, std::ios::binary};
+        if (file) {
+            m_state_buffer.assign(std::istreambuf_iterator<char>(file),
+                                  std::istreambuf_iterator<char>());
+            if (!m_game.RestoreState(m_state_buffer.data(),
+                                     m_state_buffer.size())) {
+                std::cerr << "Could not resume the game saved in "
+                          << m_state_path << std::endl;
+            }
+        }
+        m_number_pieces_of_saved_state =
+            m_game.GetGameCore().GetNumberOfSpawnedPieces();
+        m_is_game_over_of_saved_state = m_game.IsGameOver();
+    }
+
     // Center the main window
     auto desktop = sf::VideoMode::getDesktopMode();
     sf::Vector2<int> new_position{
@@ -33,6 +60,15 @@ void Controller::StartGame(sf::RenderWindow& window) {
             m_game.ProcessKeyEvent(event);
         }
 
+        // save the game whenever a piece has been locked, including the
+        // last one of a game
+        if (!m_state_path.empty() &&
+            (m_game.GetGameCore().GetNumberOfSpawnedPieces() !=
+                 m_number_pieces_of_saved_state ||
+             m_game.IsGameOver() != m_is_game_over_of_saved_state)) {
+            SaveGameState();
+        }
+
         if (!m_game.IsGameOver()) {
             long elapsed_time_since_last_update =
                 std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -52,8 +88,6 @@ void Controller::StartGame(sf::RenderWindow& window) {
                 }
             }
 
-            m_game.ProcessLockDown();
-
             // Clear screen
             window.clear(sf::Color::White);
 
@@ -69,4 +103,36 @@ void Controller::StartGame(sf::RenderWindow& window) {
             m_game.SetGameOverAnnounced();
         }
     }
+
+    if (!m_state_path.empty()) {
+        SaveGameState();
+    }
+    if (!m_replay_path.empty() &&
+        !SaveReplay(m_game.GetReplay(), m_replay_path)) {
+        std::cerr << "Could not write the replay to " << m_replay_path
+                  << std::endl;
+    }
+#ifndef NDEBUG
+    const TetrominoPoolStatistics& statistics{
+        m_game.GetDashboard().GetTetrominoPoolStatistics()};
+    std::clog << "queue tetrominoes created: " << statistics.number_created
+              << ", reused: " << statistics.number_reused << std::endl;
+#endif
+}
+
+void Controller::SaveGameState() {
+    m_number_pieces_of_saved_state =
+        m_game.GetGameCore().GetNumberOfSpawnedPieces();
+    m_is_game_over_of_saved_state = m_game.IsGameOver();
+    m_game.SaveState(m_state_buffer);
+    std::string temporary_path{m_state_path + ".tmp"};
+    std::ofstream file{temporary_path, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(m_state_buffer.data()),
+               static_cast<std::streamsize>(m_state_buffer.size()));
+    file.close();
+    if (!file ||
+        std::rename(temporary_path.c_str(), m_state_path.c_str()) != 0) {
+        std::cerr << "Could not save the game to " << m_state_path
+                  << std::endl;
+    }
 }
@@ -1,6 +1,10 @@
 #ifndef CONTROLLER_H_
 #define CONTROLLER_H_
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "Game.h"
 
 /// This class controls the entire game. It retrieves the keyboard events and
@@ -14,16 +18,38 @@ class Controller {
     ///                2D drawing.
     /// \param font:   Font for all sf::Text instances in the entire
     ///                application.
-    Controller(sf::RenderWindow& window, sf::Font& font);
+    /// \param number_rows:    number of rows of the playfield
+    /// \param number_columns: number of columns of the playfield
+    /// \param replay_path:    file to which the replay of all games is
+    ///                        written when the window is closed, no replay
+    ///                        is written if it is empty
+    /// \param state_path:     file from which a saved game is resumed if it
+    ///                        exists and to which the game state is saved
+    ///                        after every locked piece and when the window is
+    ///                        closed, nothing is saved if it is empty
+    Controller(sf::RenderWindow& window, sf::Font& font, int number_rows = 20,
+               int number_columns = 10, std::string replay_path = "",
+               std::string state_path = "");
 
     /// Starts the Tetris game.
     /// \param
     void StartGame(sf::RenderWindow&);
 
    private:
-    int m_number_rows{20};
-    int m_number_columns{10};
+    int m_number_rows;
+    int m_number_columns;
+    std::string m_replay_path;
+    std::string m_state_path;
     Game m_game;
+    // number of pieces spawned and whether the game was over when the state
+    // has been saved last
+    long m_number_pieces_of_saved_state{0};
+    bool m_is_game_over_of_saved_state{false};
+    std::vector<std::uint8_t> m_state_buffer;
+
+    /// Saves the game state to the state file, writing a temporary file
+    /// first such that a crash while saving keeps the previous state.
+    void SaveGameState();
 };
 
 #endif /* CONTROLLER_H_ */
\ No newline at end of file
@@ -132,67 +132,29 @@ Dashboard::Dashboard(float offset_window_top_border, float max_available_width,
 
 void Dashboard::InsertNextTetromino(TetrominoType shape) {
     // delete first element in queue
-    if (m_shapes_in_queue.size() > 2) {
-        m_shapes_in_queue.pop_front();
+    if (m_shapes_in_queue.size() >= kNumberShownTetrominoes) {
+        m_tetromino_pool.Release(std::move(m_shapes_in_queue.front()));
+        m_shapes_in_queue.erase(m_shapes_in_queue.begin());
     }
 
     // move remaining elements on dashboard grid 4 steps up
     for (size_t i{0}; i < m_shapes_in_queue.size(); i++) {
         TetrominoPositionType pos{
-            m_shapes_in_queue.at(i).GetPositionInGridLogicFrame()};
+            m_shapes_in_queue.at(i)->GetPositionInGridLogicFrame()};
         for (auto &elem : pos) {
             elem.first -= 5;
         }
-        m_shapes_in_queue.at(i).SetPositionInDashboard(pos);
+        m_shapes_in_queue.at(i)->SetPositionInDashboard(pos);
     }
 
-    // Insert a new element to the back of the queue and
-    // place it as the lowest element on the dashboard grid
-    TetrominoPositionType init_position{};
-    switch (shape) {
-        case TetrominoType::I:
-            init_position = {{12, 0}, {12, 1}, {12, 2}, {12, 3}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeI>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::J:
-            init_position = {{11, 0}, {12, 0}, {12, 1}, {12, 2}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeJ>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::L:
-            init_position = {{11, 2}, {12, 0}, {12, 1}, {12, 2}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeL>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::O:
-            init_position = {{11, 1}, {11, 2}, {12, 2}, {12, 1}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeO>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::S:
-            init_position = {{11, 1}, {11, 2}, {12, 1}, {12, 0}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeS>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::T:
-            init_position = {{11, 1}, {12, 0}, {12, 1}, {12, 2}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeT>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-        case TetrominoType::Z:
-            init_position = {{11, 0}, {11, 1}, {12, 1}, {12, 2}};
-            m_shapes_in_queue.emplace_back(
-                std::make_unique<ShapeZ>(m_dashboard_grid_logic, init_position),
-                m_dashboard_grid_graphic);
-            break;
-    }
+    // Insert a new element to the back of the queue and place it centered as
+    // the lowest element on the dashboard grid
+    constexpr int kLowestQueueRow{12};
+    Piece piece{MakeSpawnPiece(shape, m_number_grid_columns)};
+    piece = piece.Translated(
+        kLowestQueueRow - piece.row - piece.GetShapeInfo().bottom_row, 0);
+    m_shapes_in_queue.push_back(m_tetromino_pool.Acquire(
+        m_dashboard_grid_logic, m_dashboard_grid_graphic, piece));
 };
 
 void Dashboard::AddToScore(int score) {
@@ -207,8 +169,15 @@ void Dashboard::AddToClearedLines(int nr_cleared_lines) {
     set_origin_to_middle(m_cleared_lines_number);
 }
 
-void Dashboard::Reset() {
+void Dashboard::ClearQueue() {
+    for (auto &shape : m_shapes_in_queue) {
+        m_tetromino_pool.Release(std::move(shape));
+    }
     m_shapes_in_queue.clear();
+}
+
+void Dashboard::Reset() {
+    ClearQueue();
     m_score = 0;
     m_number_cleared_lines = 0;
     m_score_number.setString(std::to_string(m_score));
@@ -227,7 +196,7 @@ void Dashboard::draw(sf::RenderTarget &target, sf::RenderStates states) const {
     target.draw(m_cleared_lines_label2, states);
     target.draw(m_cleared_lines_number, states);
     for (auto &elem : m_shapes_in_queue) {
-        target.draw(elem, states);
+        target.draw(*elem, states);
     }
     target.draw(m_dashboard_grid_graphic, states);
 }
@@ -2,18 +2,26 @@
 #define DASHBOARD_H_
 
 #include <SFML/Graphics.hpp>
-#include <deque>
+#include <memory>
+#include <vector>
 
 #include "GridLogic.h"
 #include "TetrominoGraphic.h"
+#include "TetrominoGraphicPool.h"
 
-using TetrominoQueueType = std::deque<std::unique_ptr<TetrominoGraphic>>;
+/// Queue of upcoming tetrominoes. The queue holds only a few elements, so a
+/// vector keeping its capacity serves insertions at both ends without
+/// allocating once it has been filled for the first time.
+using TetrominoQueueType = std::vector<std::unique_ptr<TetrominoGraphic>>;
 
 /// Dashboard provides information to the player about the current game's state.
 /// It shows the queue of the upcoming shapes being drawn as the next elements
 /// after the currently active shape is locked down.
 class Dashboard : public sf::Drawable {
    public:
+    /// number of upcoming shapes the queue shows at most
+    static constexpr int kNumberShownTetrominoes{3};
+
     Dashboard() = default;
 
     /// Constructs a dashboard consisting of two rectangles with equal widths.
@@ -40,10 +48,19 @@ class Dashboard : public sf::Drawable {
     /// Increases the counter of cleared lines by nr_cleared_lines
     void AddToClearedLines(int nr_cleared_lines);
 
+    /// Removes all shapes from the queue.
+    void ClearQueue();
+
     /// Resets the dashboard (clear all numbers, empty the queue) for a new
     /// game.
     void Reset();
 
+    /// Retrieves how many tetrominoes of the queue have been created and
+    /// reused, which shows whether spawning still allocates.
+    const TetrominoPoolStatistics& GetTetrominoPoolStatistics() const {
+        return m_tetromino_pool.GetStatistics();
+    }
+
    private:
     unsigned int m_score{};
     unsigned int m_number_cleared_lines{};
@@ -60,7 +77,8 @@ class Dashboard : public sf::Drawable {
     int m_number_grid_rows{14};
     int m_number_grid_columns{4};
     GridLogic m_dashboard_grid_logic{m_number_grid_rows, m_number_grid_columns};
-    std::deque<TetrominoGraphic> m_shapes_in_queue{};
+    TetrominoGraphicPool m_tetromino_pool{};
+    TetrominoQueueType m_shapes_in_queue{};
 
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 };
@@ -0,0 +1,134 @@
+#ifndef FIXED_CAPACITY_VECTOR_H_
+#define FIXED_CAPACITY_VECTOR_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+/// Sequence container with a vector-like interface whose elements are stored
+/// inline in the object itself. Since the capacity is fixed at compile time,
+/// neither construction nor copying, inserting or erasing ever allocates heap
+/// memory. The container is meant for small sequences with a known upper
+/// bound like the squares of a tetromino. Exceeding the capacity is a
+/// programming error, which throws std::length_error in every build instead
+/// of dropping elements, so the memory behind the container is never written.
+template <typename T, std::size_t Capacity>
+class FixedCapacityVector {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    FixedCapacityVector() = default;
+
+    /// Creates a container holding a copy of every listed element.
+    /// \param elements: initial elements, at most Capacity many
+    /// \throw std::length_error if there are more than Capacity elements
+    FixedCapacityVector(std::initializer_list<T> elements) {
+        if (elements.size() > Capacity) {
+            ThrowCapacityExceeded();
+        }
+        for (const auto &element : elements) {
+            m_elements[m_size++] = element;
+        }
+    }
+
+    iterator begin() { return m_elements.data(); }
+    const_iterator begin() const { return m_elements.data(); }
+    iterator end() { return m_elements.data() + m_size; }
+    const_iterator end() const { return m_elements.data() + m_size; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    static constexpr size_type capacity() { return Capacity; }
+
+    reference operator[](size_type index) { return m_elements[index]; }
+    const_reference operator[](size_type index) const {
+        return m_elements[index];
+    }
+
+    /// Accesses an element with bounds checking
+    /// \throw std::out_of_range if index is not smaller than size()
+    reference at(size_type index) {
+        CheckIndex(index);
+        return m_elements[index];
+    }
+    const_reference at(size_type index) const {
+        CheckIndex(index);
+        return m_elements[index];
+    }
+
+    reference front() { return m_elements[0]; }
+    const_reference front() const { return m_elements[0]; }
+    reference back() { return m_elements[m_size - 1]; }
+    const_reference back() const { return m_elements[m_size - 1]; }
+
+    /// Appends an element.
+    /// \throw std::length_error if the container is full
+    void push_back(const T &element) {
+        if (m_size == Capacity) {
+            ThrowCapacityExceeded();
+        }
+        m_elements[m_size++] = element;
+    }
+
+    /// Removes the last element. The container must not be empty.
+    void pop_back() {
+        assert(m_size > 0);
+        if (m_size > 0) {
+            --m_size;
+        }
+    }
+
+    /// Removes the element at the specified position and shifts all elements
+    /// behind it one place to the front.
+    /// \return iterator following the removed element
+    iterator erase(const_iterator position) {
+        iterator target{begin() + (position - begin())};
+        for (iterator next{target + 1}; next != end(); ++next) {
+            *(next - 1) = *next;
+        }
+        --m_size;
+        return target;
+    }
+
+    void clear() { m_size = 0; }
+
+    bool operator==(const FixedCapacityVector &other) const {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        for (size_type index{0}; index < m_size; ++index) {
+            if (!(m_elements[index] == other.m_elements[index])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator!=(const FixedCapacityVector &other) const {
+        return !(*this == other);
+    }
+
+   private:
+    void CheckIndex(size_type index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("FixedCapacityVector index out of range");
+        }
+    }
+
+    [[noreturn]] static void ThrowCapacityExceeded() {
+        throw std::length_error("FixedCapacityVector capacity exceeded");
+    }
+
+    std::array<T, Capacity> m_elements{};
+    size_type m_size{0};
+};
+
+#endif /* FIXED_CAPACITY_VECTOR_H_ */
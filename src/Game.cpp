@@ -2,80 +2,37 @@
 
 #include <SFML/Graphics.hpp>
 #include <algorithm>
-#include <random>
 
-class RandomShapeFactory {
-   public:
-    static std::unique_ptr<TetrominoGraphic> create(GridLogic& grid_logic,
-                                                    GridGraphic& grid_graphic) {
-        TetrominoPositionType init_position;
-        std::unique_ptr<TetrominoGraphic> m_active_graphic_shape_ptr;
-        std::random_device rnd_dev;
-        std::mt19937 mt_engine(rnd_dev());
-        std::uniform_int_distribution<> generate_number(1, 7);
-        switch (generate_number(mt_engine)) {
-            case 1:  // create an I-Shape
-                init_position = {{0, 3}, {0, 4}, {0, 5}, {0, 6}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeI>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 2:  // create an J-Shape
-                init_position = {{0, 3}, {1, 3}, {1, 4}, {1, 5}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeJ>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 3:  // create an L-Shape
-                init_position = {{0, 5}, {1, 3}, {1, 4}, {1, 5}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeL>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 4:  // create an O-Shape
-                init_position = {{0, 4}, {0, 5}, {1, 5}, {1, 4}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeO>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 5:  // create an S-Shape
-                init_position = {{0, 4}, {0, 5}, {1, 4}, {1, 3}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeS>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 6:  // create an T-Shape
-                init_position = {{0, 4}, {1, 3}, {1, 4}, {1, 5}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeT>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-            case 7:  // create an Z-Shape
-                init_position = {{0, 3}, {0, 4}, {1, 4}, {1, 5}};
-                m_active_graphic_shape_ptr = std::make_unique<TetrominoGraphic>(
-                    std::make_unique<ShapeZ>(grid_logic, init_position),
-                    grid_graphic);
-                break;
-        }
-        return std::move(m_active_graphic_shape_ptr);
-    }
-};
+#include "TetrominoGraphic.h"
 
 Game::Game(int number_grid_rows, int number_grid_columns,
-           const sf::RenderWindow& window, sf::Font& font)
-    : m_number_grid_rows{number_grid_rows},
-      m_number_grid_columns{number_grid_columns},
-      m_is_game_over{false},
-      m_is_game_over_announced{false},
-      m_grid_logic{GridLogic(number_grid_rows, number_grid_columns)} {
+           const sf::RenderWindow& window, sf::Font& font,
+           GravityMode gravity_mode, int preview_length)
+    : m_game_core{number_grid_rows, number_grid_columns, gravity_mode,
+                  PieceRandomizer{}, preview_length, &m_event_ring},
+      m_replay_recorder{m_game_core},
+      m_is_game_over_announced{false} {
     // Create a drawble grid object
     float relative_top_margin{0.1f};
     float window_width{static_cast<float>(window.getSize().x)};
     float window_height{static_cast<float>(window.getSize().y)};
 
-    float grid_height{(1.0f - 2.0f * relative_top_margin) * window_height};
-    float grid_cell_side_length =
-        grid_height / static_cast<float>(number_grid_rows);
+    // the grid is placed right of the dashboard, which keeps at least the
+    // width it has next to the default grid of 20 x 10 cells, i.e. a grid
+    // half as wide as high. The cells are as large as both the height and
+    // the remaining width allow, so wide grids shrink instead of reaching
+    // out of the window.
+    float max_grid_height{(1.0f - 2.0f * relative_top_margin) *
+                          window_height};
+    float min_dashboard_width{(1.0f - relative_top_margin) * window_width -
+                              0.5f * max_grid_height};
+    float max_grid_width{(1.0f - relative_top_margin) * window_width -
+                         min_dashboard_width};
+    float grid_cell_side_length{
+        std::min(max_grid_height / static_cast<float>(number_grid_rows),
+                 max_grid_width / static_cast<float>(number_grid_columns))};
+    float grid_height{static_cast<float>(number_grid_rows) *
+                      grid_cell_side_length};
     float grid_width{static_cast<float>(number_grid_columns) *
                      grid_cell_side_length};
 
@@ -86,13 +43,28 @@ Game::Game(int number_grid_rows, int number_grid_columns,
     m_grid_graphic = GridGraphic(number_grid_rows, number_grid_columns,
                                  grid_pos_x_top_left_corner,
                                  grid_pos_y_top_left_corner, grid_height);
+    float cell_side_length{m_grid_graphic.GetGridCellSideLength()};
+    for (int type{0}; type < kNumberTetrominoTypes; ++type) {
+        sf::Color color{GetSfColor(
+            GetTetrominoColor(static_cast<TetrominoType>(type)))};
+        m_block_squares[type].setSize(
+            sf::Vector2f(cell_side_length, cell_side_length));
+        m_block_squares[type].setFillColor(color);
+
+        // the ghost consists of outlined squares only, the outline is drawn
+        // inside of the squares to not overlap neighbouring cells
+        m_ghost_squares[type] = m_block_squares[type];
+        m_ghost_squares[type].setFillColor(sf::Color::Transparent);
+        m_ghost_squares[type].setOutlineColor(color);
+        m_ghost_squares[type].setOutlineThickness(-0.1f * cell_side_length);
+    }
 
     // generate a dashboard
     float offset_window_top_border{0.1f *
                                    static_cast<float>(window.getSize().y)};
     float available_width{window.getSize().x - grid_width -
                           0.1f * window.getSize().x};
-    float max_available_height{grid_height};
+    float max_available_height{max_grid_height};
     m_dashboard = Dashboard(offset_window_top_border, available_width,
                             max_available_height, font);
 
@@ -102,14 +74,6 @@ Game::Game(int number_grid_rows, int number_grid_columns,
     m_game_over_text.setFont(font);
     m_game_over_text.setCharacterSize(60);
     m_game_over_text.setStyle(sf::Text::Bold);
-    auto grid_position_top_left_corner =
-        m_grid_graphic.GetPositionRelativeToWindow(0, 0);
-    auto grid_position_top_right_corner =
-        m_grid_graphic.GetPositionRelativeToWindow(0,
-                                                   m_number_grid_columns - 1);
-    auto grid_position_bottom_left_corner =
-        m_grid_graphic.GetPositionRelativeToWindow(m_number_grid_rows - 1, 0);
-
     float text_position_x{grid_pos_x_top_left_corner + grid_width / 2.f};
     float text_position_y{grid_pos_y_top_left_corner + grid_height / 3.f};
 
@@ -133,227 +97,112 @@ Game::Game(int number_grid_rows, int number_grid_columns,
     label_height = m_start_new_game_text.getGlobalBounds().height;
     m_start_new_game_text.setOrigin(label_width / 2.f, label_height / 2.f);
 
-    StartNewGame();
+    ShowNextTetrominoesOnDashboard();
 }
 
 void Game::ProcessKeyEvent(sf::Event event) {
-    if (m_active_shape) {
-        // process keyboard event for the active shape
-        if ((event.type == sf::Event::KeyPressed) &&
-            (event.key.code == sf::Keyboard::Left) && (!m_is_game_over)) {
-            m_active_shape->MoveOneStep(Direction::left);
-        } else if ((event.type == sf::Event::KeyPressed) &&
-                   (event.key.code == sf::Keyboard::Right) &&
-                   (!m_is_game_over)) {
-            m_active_shape->MoveOneStep(Direction::right);
-        } else if ((event.type == sf::Event::KeyPressed) &&
-                   (event.key.code == sf::Keyboard::Down) &&
-                   (!m_is_game_over)) {
-            bool is_movement_succeed{
-                m_active_shape->MoveOneStep(Direction::down)};
-            if (!is_movement_succeed &&
-                (m_active_shape->GetHighestRow() == 0)) {
-                m_is_game_over = true;
-            }
-        } else if ((event.type == sf::Event::KeyPressed) &&
-                   (event.key.code == sf::Keyboard::Up) && (!m_is_game_over)) {
-            m_active_shape->Rotate();
-        } else if ((event.type == sf::Event::KeyPressed) &&
-                   (event.key.control) && (event.key.code == sf::Keyboard::N)) {
-            StartNewGame();
-        }
+    if (event.type != sf::Event::KeyPressed) {
+        return;
+    }
+    if (event.key.control && (event.key.code == sf::Keyboard::N)) {
+        StartNewGame();
+    } else if (event.key.code == sf::Keyboard::Left) {
+        ProcessInput(GameInput::move_left);
+    } else if (event.key.code == sf::Keyboard::Right) {
+        ProcessInput(GameInput::move_right);
+    } else if (event.key.code == sf::Keyboard::Down) {
+        ProcessInput(GameInput::move_down);
+    } else if (event.key.code == sf::Keyboard::Space) {
+        ProcessInput(GameInput::hard_drop);
+    } else if (event.key.code == sf::Keyboard::Up) {
+        ProcessInput(GameInput::rotate);
     }
 }
 
-void Game::ProcessLockDown() {
-    if (m_active_shape) {
-        // In case the active shape is locked down because it reached the lowest
-        // possible level on the grid, put it into m_locked_shapes_on_grid. Then
-        // generate a new shape and put it in front of m_shapes_in_queue and pop
-        // a shape from the back of the m_shapes_in_queue. Finally, check
-        // occupancy grid for entirely occupied rows and clear them all if any.
-        if (m_active_shape->IsLocked()) {
-            m_locked_shapes_on_grid.push_back(std::move(m_active_shape));
-            m_active_shape = std::move(m_shapes_in_queue.back());
-            m_shapes_in_queue.pop_back();
-            m_shapes_in_queue.push_front(std::move(
-                RandomShapeFactory::create(m_grid_logic, m_grid_graphic)));
-            m_dashboard.InsertNextTetromino(
-                m_shapes_in_queue.at(0)->GetTetrominoType());
-
-            // check the occupancy grid for fully occupied rows
-            std::vector<int> vector_of_indexes_of_fully_occupied_rows =
-                m_grid_logic.GetIndexesOfFullyOccupiedRows();
-
-            // Clear entirely occupied rows
-            if (!vector_of_indexes_of_fully_occupied_rows.empty()) {
-                // Identify all affected tetrominoes by the fully occupied row
-                // and remove their affected parts (squares)
-                for (const int occupied_row_index :
-                     vector_of_indexes_of_fully_occupied_rows) {
-                    for (auto graphical_shape_iterator =
-                             m_locked_shapes_on_grid.begin();
-                         graphical_shape_iterator !=
-                         m_locked_shapes_on_grid.end();) {
-                        auto logical_chape_iterator =
-                            (*graphical_shape_iterator)
-                                ->GetIteratorToBeginOfLogicalTetromino();
-                        for (auto graphical_iterator =
-                                 (*graphical_shape_iterator)
-                                     ->GetIteratorToBeginOfGraphicalTetromino();
-                             graphical_iterator !=
-                             (*graphical_shape_iterator)
-                                 ->GetIteratorToEndOfGraphicalTetromino();) {
-                            if (logical_chape_iterator->first ==
-                                occupied_row_index) {
-                                (*graphical_shape_iterator)
-                                    ->DeleteTetrominoSquare(
-                                        graphical_iterator,
-                                        logical_chape_iterator);
-                            } else {
-                                ++graphical_iterator;
-                                ++logical_chape_iterator;
-                            }
-                        }
-                        if ((*graphical_shape_iterator)->GetSquares().empty()) {
-                            graphical_shape_iterator =
-                                m_locked_shapes_on_grid.erase(
-                                    graphical_shape_iterator);
-                        } else {
-                            ++graphical_shape_iterator;
-                        }
-                    }
-                }
-
-                // Free released rows
-                m_grid_logic.FreeAllEntirelyOccupiedRows();
+void Game::MoveActiveShapeOneStepDown() { ProcessInput(GameInput::move_down); }
 
-                // Unlock the movability of each tetromino on the grid, move
-                // each one down until it hits an obstacle and lock it again
-                for (auto& shape : m_locked_shapes_on_grid) {
-                    shape->Release();
-                    while (shape->MoveOneStep(Direction::down)) {
-                    }
-                    shape->LockDown();
-                }
+void Game::StartNewGame() { ProcessInput(GameInput::new_game); }
 
-                // update the score
-                // use the original BPS scoring system, see
-                // https://tetris.wiki/Scoring#Recent_guideline_compatible_games)
-                std::sort(vector_of_indexes_of_fully_occupied_rows.begin(),
-                          vector_of_indexes_of_fully_occupied_rows.end());
-
-                // First, identify single, double, triple or tetris
-                std::vector<int> line_clears;
-                int nr_successively_cleared_lines{1};
-                int prev_index{-10};
-                int total_number_cleared_lines{static_cast<int>(
-                    vector_of_indexes_of_fully_occupied_rows.size())};
-                for (size_t i = 0; i < total_number_cleared_lines; i++) {
-                    int row_index{
-                        vector_of_indexes_of_fully_occupied_rows.at(i)};
-                    bool is_first_loop_iteration{
-                        (i == 0) && (total_number_cleared_lines > 1)};
-                    if (is_first_loop_iteration) {
-                        prev_index = row_index;
-                        continue;
-                    }
-                    bool is_prev_line_cleared{(row_index - prev_index) == 1};
-                    if (is_prev_line_cleared) {
-                        ++nr_successively_cleared_lines;
-                        bool is_not_last_loop_iteration{
-                            i < total_number_cleared_lines - 1};
-                        if (is_not_last_loop_iteration) {
-                            prev_index = row_index;
-                            continue;
-                        }
-                    }
-                    line_clears.push_back(nr_successively_cleared_lines);
-                    nr_successively_cleared_lines = 1;
-                    prev_index = row_index;
-                }
-
-                // Then, calculate the corresponding score
-                for (int line_clear : line_clears) {
-                    switch (line_clear) {
-                        case 1:
-                            m_dashboard.AddToScore(40);
-                            m_dashboard.AddToClearedLines(1);
-                            break;
-                        case 2:
-                            m_dashboard.AddToScore(100);
-                            m_dashboard.AddToClearedLines(2);
-                            break;
-                        case 3:
-                            m_dashboard.AddToScore(300);
-                            m_dashboard.AddToClearedLines(3);
-                            break;
-                        case 4:
-                            m_dashboard.AddToScore(1200);
-                            m_dashboard.AddToClearedLines(4);
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
-        }
+bool Game::RestoreState(const std::uint8_t* data, std::size_t size) {
+    if (!m_game_core.RestoreState(data, size)) {
+        return false;
     }
+    m_replay_recorder = ReplayRecorder{m_game_core};
+    m_is_game_over_announced = false;
+    m_dashboard.Reset();
+    m_dashboard.AddToScore(m_game_core.GetScore());
+    m_dashboard.AddToClearedLines(m_game_core.GetNumberOfClearedLines());
+    ShowNextTetrominoesOnDashboard();
+    return true;
 }
 
-void Game::MoveActiveShapeOneStepDown() {
-    if (m_active_shape) {
-        bool is_movement_succeed{m_active_shape->MoveOneStep(Direction::down)};
-        if (!is_movement_succeed && (m_active_shape->GetHighestRow() == 0)) {
-            m_is_game_over = true;
+void Game::ProcessInput(GameInput input) {
+    StepResult result{m_game_core.Step(input)};
+    m_replay_recorder.Record(input, m_game_core);
+    if (input == GameInput::new_game) {
+        m_is_game_over_announced = false;
+        m_dashboard.Reset();
+        ShowNextTetrominoesOnDashboard();
+        return;
+    }
+    if (result.number_cleared_lines > 0) {
+        m_dashboard.AddToScore(result.score_gained);
+        m_dashboard.AddToClearedLines(result.number_cleared_lines);
+    }
+    if (result.is_piece_locked && !result.is_game_over) {
+        // The next shape has been spawned. If the queue is at least as long as
+        // the dashboard shows, only the last shown shape is new.
+        const PieceQueue& next_tetrominoes{m_game_core.GetNextTetrominoes()};
+        if (next_tetrominoes.size() >= Dashboard::kNumberShownTetrominoes) {
+            m_dashboard.InsertNextTetromino(
+                next_tetrominoes[Dashboard::kNumberShownTetrominoes - 1]);
+        } else {
+            ShowNextTetrominoesOnDashboard();
         }
     }
 }
 
-void Game::StartNewGame() {
-    // Reset the state of current game
-    m_is_game_over = false;
-    m_is_game_over_announced = false;
-    m_grid_logic.FreeEntireGrid();
-    m_shapes_in_queue.clear();
-    m_locked_shapes_on_grid.clear();
-    m_active_shape = nullptr;
-    m_dashboard.Reset();
-
-    // generate three random shapes and put them all in a queue
-    m_shapes_in_queue.push_front(
-        std::move(RandomShapeFactory::create(m_grid_logic, m_grid_graphic)));
-    m_shapes_in_queue.push_front(
-        std::move(RandomShapeFactory::create(m_grid_logic, m_grid_graphic)));
-    m_shapes_in_queue.push_front(
-        std::move(RandomShapeFactory::create(m_grid_logic, m_grid_graphic)));
-
-    // generate a shape being actively moved on the grid
-    m_active_shape =
-        std::move(RandomShapeFactory::create(m_grid_logic, m_grid_graphic));
+void Game::ShowNextTetrominoesOnDashboard() {
+    const PieceQueue& next_tetrominoes{m_game_core.GetNextTetrominoes()};
+    int number_shown_tetrominoes{std::min(
+        next_tetrominoes.size(), Dashboard::kNumberShownTetrominoes)};
+    m_dashboard.ClearQueue();
+    for (int index{0}; index < number_shown_tetrominoes; ++index) {
+        m_dashboard.InsertNextTetromino(next_tetrominoes[index]);
+    }
+}
 
-    // insert all elements from m_shapes_in_queue into the dashboard queue
-    m_dashboard.InsertNextTetromino(
-        m_shapes_in_queue.at(0)->GetTetrominoType());
-    m_dashboard.InsertNextTetromino(
-        m_shapes_in_queue.at(1)->GetTetrominoType());
-    m_dashboard.InsertNextTetromino(
-        m_shapes_in_queue.at(2)->GetTetrominoType());
+void Game::DrawSquare(sf::RenderTarget& target, sf::RenderStates states,
+                      const sf::RectangleShape& square, int row,
+                      int column) const {
+    states.transform.translate(
+        *m_grid_graphic.GetPositionRelativeToWindow(row, column));
+    target.draw(square, states);
 }
 
 void Game::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    if (m_is_game_over) {
+    if (m_game_core.IsGameOver()) {
         target.draw(m_game_over_text, states);
         target.draw(m_start_new_game_text, states);
     } else {
-        if (m_active_shape) {
-            target.draw(*m_active_shape, states);
-        }
-        if (!m_locked_shapes_on_grid.empty()) {
-            for (const auto& graphical_shape : m_locked_shapes_on_grid) {
-                target.draw(*graphical_shape);
+        const Piece& active_piece{m_game_core.GetActivePiece()};
+        int type{static_cast<int>(active_piece.type)};
+        int ghost_drop_distance{m_game_core.GetGhostDropDistance()};
+        for (const auto& offset : active_piece.GetSquareOffsets()) {
+            int row{active_piece.row + offset.first};
+            int column{active_piece.column + offset.second};
+            DrawSquare(target, states, m_block_squares[type], row, column);
+            if (ghost_drop_distance > 0) {
+                DrawSquare(target, states, m_ghost_squares[type],
+                           row + ghost_drop_distance, column);
             }
         }
+        m_game_core.GetGridLogic().ForEachLockedCell(
+            [this, &target, &states](int row, int column, TetrominoType type) {
+                DrawSquare(target, states,
+                           m_block_squares[static_cast<int>(type)], row,
+                           column);
+            });
         target.draw(m_grid_graphic, states);
         target.draw(m_dashboard);
     }
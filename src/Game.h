@@ -1,28 +1,28 @@
 #ifndef GAME_H_
 #define GAME_H_
 
-#include <deque>
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "Dashboard.h"
+#include "GameCore.h"
 #include "GridGraphic.h"
-#include "GridLogic.h"
-#include "TetrominoGraphic.h"
-
-/// The Game class provides all necessities to start a game. Concrete, it
-/// constructs the Tetris grid, a dashboard, and all tetrominoes falling from
-/// top to bottom. Tetrominoes are organized in the following way: Once a
-/// tetromino shape is randomly generated, it is pushed into a waiting queue
-/// containing three tetrominoes in total. Then one tetromino is poped from
-/// another end of the queue and referred to as an active shape. The player can
-/// relocate and rotate this active shape as long as it is not locked down. When
-/// the active shape has reached the lowest possible free line on the grid, it
-/// is then locked down and pushed into another container that contains all the
-/// locked shapes. Furthermore, the Game class offers methods to process
-/// keyboard events, shapes lock down and to restart the game.
+#include "Replay.h"
+
+/// The Game class is the graphical view of a game. The entire game state,
+/// i.e. the grid, the falling tetromino, the queue of the next tetrominoes and
+/// the scoring, is kept by a GameCore, which does not depend on SFML. The Game
+/// class translates keyboard events into inputs of the game core, feeds the
+/// outcome of every step into the dashboard and draws the grid from the state
+/// of the game core. Locked cells, the active tetromino and its ghost are
+/// drawn by one square per tetromino type which is placed at every cell.
 class Game : public sf::Drawable {
    public:
+    /// number of events the event ring holds, see GetEventRing()
+    static constexpr std::size_t kEventRingCapacity{1024};
+
     /// Creates a drawable grid object, a drawable dashboard, sets up the
     /// game over / new game text message, and starts a new game.
     /// \param number_grid_rows: Number of rows in the game grid.
@@ -30,20 +30,25 @@ class Game : public sf::Drawable {
     /// \param window: Reference to a window which serves as a target
     ///                for 2D drawing.
     /// \param font: Font for all sf::Text instances in the entire application.
+    /// \param gravity_mode: How the blocks above cleared rows fall down. Line
+    ///                      gravity moves whole rows and is the fastest,
+    ///                      cascade gravity lets each group of connected
+    ///                      blocks fall on its own.
+    /// \param preview_length: Number of tetrominoes waiting behind the
+    ///                        active one, see PieceQueue. The dashboard shows
+    ///                        the first three of them.
     Game(int number_grid_rows, int number_grid_columns,
-         const sf::RenderWindow& window, sf::Font& font);
+         const sf::RenderWindow& window, sf::Font& font,
+         GravityMode gravity_mode = GravityMode::line,
+         int preview_length = PieceQueue::kDefaultLength);
 
     /// Processes an event from the keyboard
     /// \param event: event being processed
     void ProcessKeyEvent(sf::Event event);
 
-    /// Processes a lock-down-state. A lock-down-state is achieved when the next
-    /// tetromino shape cannot be placed on the grid anymore because the grid is
-    /// already full of shapes.
-    void ProcessLockDown();
-
-    /// Moves the active shape one step downwards. The method sets also the
-    /// corresponding flag when the game is over.
+    /// Moves the active shape one step downwards. A shape which cannot move
+    /// any further is locked down and the next shape is spawned. The method
+    /// sets also the corresponding flag when the game is over.
     void MoveActiveShapeOneStepDown();
 
     /// Starts a new game by resetting all current states like scoring, list of
@@ -51,7 +56,7 @@ class Game : public sf::Drawable {
     void StartNewGame();
 
     /// Retrieves the information whether the game is over or not.
-    bool IsGameOver() { return m_is_game_over; };
+    bool IsGameOver() const { return m_game_core.IsGameOver(); };
 
     /// In case the game is over, retrieves the information about whether this
     /// fact has been already announced. This information is then utilized in
@@ -62,18 +67,67 @@ class Game : public sf::Drawable {
     /// Sets the game-over-announcement flag to true.
     void SetGameOverAnnounced() { m_is_game_over_announced = true; };
 
+    /// Writes the entire state of the game, see GameCore::SaveState().
+    /// \param buffer: buffer receiving the state
+    void SaveState(std::vector<std::uint8_t>& buffer) const {
+        m_game_core.SaveState(buffer);
+    }
+
+    /// Continues a game from a state written by SaveState(), see
+    /// GameCore::RestoreState(). The view is drawn from the game core anyway,
+    /// so only the numbers and the queue of the dashboard are refreshed. The
+    /// replay is recorded anew from the restored state.
+    /// \param data: state written by SaveState()
+    /// \param size: number of bytes of the state
+    /// \return false if the data is not a valid state of a game with the
+    ///         same grid dimensions, in which case the game is unchanged
+    bool RestoreState(const std::uint8_t* data, std::size_t size);
+
+    /// Retrieves the ring receiving the events of all steps, e.g. for an
+    /// observer thread collecting statistics. Key events and periodic drops
+    /// emit their events while being processed, see GameCore::SetEventRing().
+    /// Events are dropped while nobody takes them from the ring.
+    GameEventRing& GetEventRing() { return m_event_ring; }
+
+    /// Retrieves the state of the game the view is drawn from.
+    const GameCore& GetGameCore() const { return m_game_core; }
+
+    /// Retrieves all inputs of the player and the gravity timer so far, from
+    /// which the games since the construction or the latest restore can be
+    /// reproduced.
+    const Replay& GetReplay() const { return m_replay_recorder.GetReplay(); }
+
+    /// Retrieves the dashboard showing the queue and the scoring.
+    const Dashboard& GetDashboard() const { return m_dashboard; }
+
    private:
-    int m_number_grid_rows, m_number_grid_columns;
-    bool m_is_game_over, m_is_game_over_announced;
+    // the ring is constructed first to receive the start of the first game
+    GameEventRing m_event_ring{kEventRingCapacity};
+    GameCore m_game_core;
+    ReplayRecorder m_replay_recorder;
+    bool m_is_game_over_announced;
     sf::Text m_game_over_text;
     sf::Text m_start_new_game_text;
-    GridLogic m_grid_logic;
     GridGraphic m_grid_graphic;
-    std::deque<std::unique_ptr<TetrominoGraphic>> m_shapes_in_queue;
-    std::vector<std::unique_ptr<TetrominoGraphic>> m_locked_shapes_on_grid;
-    std::unique_ptr<TetrominoGraphic> m_active_shape;
+    // one square per tetromino type which is drawn at every cell of that type
+    std::array<sf::RectangleShape, kNumberTetrominoTypes> m_block_squares;
+    // one outlined square per tetromino type for the ghost of the active shape
+    std::array<sf::RectangleShape, kNumberTetrominoTypes> m_ghost_squares;
     Dashboard m_dashboard;
 
+    /// Passes an input to the game core, records it and updates the dashboard
+    /// with the outcome of the step.
+    /// \param input: input being processed
+    void ProcessInput(GameInput input);
+
+    /// Fills the dashboard queue with the first next tetrominoes.
+    void ShowNextTetrominoesOnDashboard();
+
+    /// Draws a square at the position of a grid cell.
+    void DrawSquare(sf::RenderTarget& target, sf::RenderStates states,
+                    const sf::RectangleShape& square, int row,
+                    int column) const;
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 };
 
@@ -0,0 +1,374 @@
+#include "GameCore.h"
+
+#include <algorithm>
+
+#include "ByteStream.h"
+
+namespace {
+
+constexpr char kStateMagic[4]{'T', 'G', 'S', 'T'};
+constexpr std::uint8_t kStateVersion{1};
+// upper bound of the score and the counters, which are kept as int
+constexpr std::uint64_t kMaxCounterValue{0x7FFFFFFF};
+
+// Signed values are stored as 16 bit two's complement, which covers the
+// box positions of pieces on grids of any supported size
+std::int64_t ToSigned16(std::uint64_t value) {
+    return static_cast<std::int16_t>(static_cast<std::uint16_t>(value));
+}
+
+}  // namespace
+
+GameCore::GameCore(int number_grid_rows, int number_grid_columns,
+                   GravityMode gravity_mode,
+                   const PieceRandomizer& piece_randomizer,
+                   int preview_length, GameEventRing* event_ring)
+    : m_grid_logic{number_grid_rows, number_grid_columns},
+      m_gravity_mode{gravity_mode},
+      m_next_tetrominoes{preview_length},
+      m_piece_randomizer{piece_randomizer},
+      m_event_ring{event_ring} {
+    m_cleared_rows.reserve(number_grid_rows);
+    StartNewGame();
+}
+
+StepResult GameCore::Step(GameInput input) {
+    ++m_number_ticks;
+    StepResult result;
+    if (input == GameInput::new_game) {
+        StartNewGame();
+        return result;
+    }
+    if (m_is_game_over) {
+        result.is_game_over = true;
+        return result;
+    }
+
+    switch (input) {
+        case GameInput::move_left:
+        case GameInput::move_right:
+            if (m_grid_logic.TryTranslate(
+                    m_active_piece, 0,
+                    input == GameInput::move_left ? -1 : 1) ==
+                MoveResult::success) {
+                EmitEvent(GameEventType::move);
+            }
+            break;
+        case GameInput::move_down:
+            if (m_grid_logic.TryTranslate(m_active_piece, 1, 0) ==
+                MoveResult::success) {
+                EmitEvent(GameEventType::move);
+            } else {
+                LockActivePiece(result);
+            }
+            break;
+        case GameInput::rotate:
+            if (m_grid_logic.TryRotate(m_active_piece) == MoveResult::success) {
+                EmitEvent(GameEventType::rotate);
+            }
+            break;
+        case GameInput::hard_drop: {
+            // one query for the landing row, one grid request to get there
+            int drop_distance{m_grid_logic.GetDropDistance(m_active_piece)};
+            if (drop_distance > 0) {
+                m_grid_logic.TryTranslate(m_active_piece, drop_distance, 0);
+                EmitEvent(GameEventType::move, drop_distance);
+            }
+            LockActivePiece(result);
+            break;
+        }
+        default:
+            break;
+    }
+    if (result.score_gained > 0) {
+        EmitEvent(GameEventType::score, result.score_gained);
+    }
+    if (m_is_game_over) {
+        EmitEvent(GameEventType::game_over, m_score);
+    }
+    result.is_game_over = m_is_game_over;
+    return result;
+}
+
+void GameCore::StartNewGame() {
+    m_grid_logic.FreeEntireGrid();
+    m_number_spawned_pieces = 0;
+    m_score = 0;
+    m_number_cleared_lines = 0;
+    m_is_game_over = false;
+    m_next_tetrominoes.Fill(m_piece_randomizer);
+    EmitEvent(GameEventType::new_game);
+    SpawnNextPiece();
+}
+
+void GameCore::StartNewGame(const PieceRandomizer& piece_randomizer) {
+    m_piece_randomizer = piece_randomizer;
+    StartNewGame();
+}
+
+std::uint64_t GameCore::ComputeStateHash() const {
+    std::uint64_t hash{m_grid_logic.ComputeStateHash()};
+    hash = CombineHash(hash, static_cast<std::uint64_t>(m_active_piece.type));
+    hash = CombineHash(hash,
+                       static_cast<std::uint64_t>(m_active_piece.orientation));
+    hash = CombineHash(hash, static_cast<std::uint64_t>(m_active_piece.row));
+    hash = CombineHash(hash, static_cast<std::uint64_t>(m_active_piece.column));
+    hash = CombineHash(hash,
+                       static_cast<std::uint64_t>(m_next_tetrominoes.size()));
+    for (int index{0}; index < m_next_tetrominoes.size(); ++index) {
+        hash = CombineHash(
+            hash, static_cast<std::uint64_t>(m_next_tetrominoes[index]));
+    }
+    hash = CombineHash(hash, static_cast<std::uint64_t>(m_score));
+    hash = CombineHash(hash,
+                       static_cast<std::uint64_t>(m_number_cleared_lines));
+    hash = CombineHash(hash,
+                       static_cast<std::uint64_t>(m_number_spawned_pieces));
+    hash = CombineHash(hash, m_is_game_over ? 1 : 0);
+    return CombineHash(hash, m_number_ticks);
+}
+
+void GameCore::SaveState(std::vector<std::uint8_t>& buffer) const {
+    buffer.clear();
+    ByteWriter writer{buffer};
+    for (char magic_character : kStateMagic) {
+        writer.PutFixed(static_cast<std::uint8_t>(magic_character), 1);
+    }
+    writer.PutFixed(kStateVersion, 1);
+    writer.PutFixed(static_cast<std::uint64_t>(m_gravity_mode), 1);
+    writer.PutFixed(static_cast<std::uint64_t>(m_grid_logic.GetNumberOfRows()),
+                    2);
+    writer.PutFixed(
+        static_cast<std::uint64_t>(m_grid_logic.GetNumberOfColumns()), 2);
+    m_piece_randomizer.WriteState(writer);
+
+    writer.PutFixed(static_cast<std::uint64_t>(m_active_piece.type), 1);
+    writer.PutFixed(static_cast<std::uint64_t>(m_active_piece.orientation), 1);
+    writer.PutFixed(static_cast<std::uint64_t>(m_active_piece.row), 2);
+    writer.PutFixed(static_cast<std::uint64_t>(m_active_piece.column), 2);
+    writer.PutFixed(static_cast<std::uint64_t>(m_next_tetrominoes.size()), 1);
+    for (int index{0}; index < m_next_tetrominoes.size(); ++index) {
+        writer.PutFixed(static_cast<std::uint64_t>(m_next_tetrominoes[index]),
+                        1);
+    }
+    writer.PutVarint(static_cast<std::uint64_t>(m_number_spawned_pieces));
+    writer.PutVarint(m_number_ticks);
+    writer.PutVarint(static_cast<std::uint64_t>(m_score));
+    writer.PutVarint(static_cast<std::uint64_t>(m_number_cleared_lines));
+    writer.PutFixed(m_is_game_over ? 1 : 0, 1);
+
+    std::size_t cells_size{m_grid_logic.GetPackedCellsSize()};
+    m_grid_logic.ExportPackedCells(writer.PutBytes(cells_size), cells_size);
+}
+
+bool GameCore::RestoreState(const std::uint8_t* data, std::size_t size) {
+    ByteReader reader{data, size};
+    for (char magic_character : kStateMagic) {
+        if (reader.GetFixed(1) != static_cast<std::uint8_t>(magic_character)) {
+            return false;
+        }
+    }
+    std::uint64_t version{reader.GetFixed(1)};
+    if (version != kStateVersion ||
+        reader.GetFixed(1) != static_cast<std::uint64_t>(m_gravity_mode) ||
+        static_cast<int>(reader.GetFixed(2)) !=
+            m_grid_logic.GetNumberOfRows() ||
+        static_cast<int>(reader.GetFixed(2)) !=
+            m_grid_logic.GetNumberOfColumns()) {
+        return false;
+    }
+    PieceRandomizer piece_randomizer{m_piece_randomizer};
+    if (!piece_randomizer.ReadState(reader)) {
+        return false;
+    }
+
+    std::uint64_t type{reader.GetFixed(1)};
+    std::uint64_t orientation{reader.GetFixed(1)};
+    std::int64_t row{ToSigned16(reader.GetFixed(2))};
+    std::int64_t column{ToSigned16(reader.GetFixed(2))};
+    bool is_valid{type < kNumberTetrominoTypes &&
+                  orientation < kNumberOrientations};
+    std::uint64_t preview_length{reader.GetFixed(1)};
+    if (preview_length < static_cast<std::uint64_t>(PieceQueue::kMinLength) ||
+        preview_length > static_cast<std::uint64_t>(PieceQueue::kMaxLength)) {
+        return false;
+    }
+    std::array<TetrominoType, PieceQueue::kMaxLength> next_tetrominoes;
+    for (std::uint64_t index{0}; index < preview_length; ++index) {
+        std::uint64_t value{reader.GetFixed(1)};
+        is_valid = is_valid && value < kNumberTetrominoTypes;
+        next_tetrominoes[index] = static_cast<TetrominoType>(value);
+    }
+    std::uint64_t number_spawned_pieces{reader.GetVarint()};
+    std::uint64_t number_ticks{reader.GetVarint()};
+    std::uint64_t score{reader.GetVarint()};
+    std::uint64_t number_cleared_lines{reader.GetVarint()};
+    std::uint64_t is_game_over{reader.GetFixed(1)};
+    const std::uint8_t* cells{
+        reader.GetBytes(m_grid_logic.GetPackedCellsSize())};
+    if (!reader.IsValid() || !reader.IsAtEnd() || !is_valid ||
+        is_game_over > 1 || score > kMaxCounterValue ||
+        number_cleared_lines > kMaxCounterValue ||
+        number_spawned_pieces > kMaxCounterValue) {
+        return false;
+    }
+    Piece active_piece{MakePiece(static_cast<TetrominoType>(type),
+                                 static_cast<Orientation>(orientation),
+                                 static_cast<int>(row),
+                                 static_cast<int>(column))};
+    // Occupied cells without a type belong to the piece in play, so they
+    // have to be exactly the cells of the active piece, which must not
+    // overlap a locked cell. The piece which could not be spawned after game
+    // over has never been placed, so no such cell is left then.
+    int number_rows{m_grid_logic.GetNumberOfRows()};
+    int number_columns{m_grid_logic.GetNumberOfColumns()};
+    const std::uint8_t* cell_types{cells + m_grid_logic.GetPackedBitsSize()};
+    auto is_unlocked_piece_cell = [&](int cell_row, int cell_column) {
+        std::size_t index{
+            static_cast<std::size_t>(cell_row * number_columns + cell_column)};
+        bool is_occupied{((cells[index / 8] >> (index % 8)) & 1U) != 0};
+        unsigned cell_type{(cell_types[index / 2] >> (4 * (index % 2))) &
+                           0xFU};
+        return is_occupied &&
+               cell_type == static_cast<unsigned>(TetrominoType::UNDEFINED);
+    };
+    int number_piece_cells{0};
+    if (is_game_over == 0) {
+        const TetrominoShapeInfo& info{active_piece.GetShapeInfo()};
+        if (row + info.top_row < 0 || row + info.bottom_row >= number_rows ||
+            column + info.left_column < 0 ||
+            column + info.right_column >= number_columns) {
+            return false;
+        }
+        TetrominoPositionType piece_cells{active_piece.GetCells()};
+        for (const auto& cell : piece_cells) {
+            if (!is_unlocked_piece_cell(cell.first, cell.second)) {
+                return false;
+            }
+        }
+        number_piece_cells = static_cast<int>(piece_cells.size());
+    }
+    int number_unlocked_cells{0};
+    for (int cell_row{0}; cell_row < number_rows; ++cell_row) {
+        for (int cell_column{0}; cell_column < number_columns;
+             ++cell_column) {
+            if (is_unlocked_piece_cell(cell_row, cell_column)) {
+                ++number_unlocked_cells;
+            }
+        }
+    }
+    if (number_unlocked_cells != number_piece_cells) {
+        return false;
+    }
+    if (!m_grid_logic.ImportPackedCells(cells,
+                                        m_grid_logic.GetPackedCellsSize())) {
+        return false;
+    }
+
+    m_piece_randomizer = piece_randomizer;
+    m_active_piece = active_piece;
+    m_next_tetrominoes.Assign(next_tetrominoes.data(),
+                              static_cast<int>(preview_length));
+    m_number_spawned_pieces = static_cast<long>(number_spawned_pieces);
+    m_number_ticks = number_ticks;
+    m_score = static_cast<int>(score);
+    m_number_cleared_lines = static_cast<int>(number_cleared_lines);
+    m_is_game_over = is_game_over != 0;
+    return true;
+}
+
+void GameCore::SpawnNextPiece() {
+    // Shapes spawn centered in the first row on grids of any width
+    m_active_piece = MakeSpawnPiece(
+        m_next_tetrominoes.PopAndPush(m_piece_randomizer.Next()),
+        m_grid_logic.GetNumberOfColumns());
+    ++m_number_spawned_pieces;
+    if (m_grid_logic.TryPlace(m_active_piece) != MoveResult::success) {
+        m_is_game_over = true;
+        return;
+    }
+    EmitEvent(GameEventType::spawn, static_cast<int>(m_number_spawned_pieces));
+}
+
+void GameCore::LockActivePiece(StepResult& result) {
+    result.is_piece_locked = true;
+    m_grid_logic.LockCells(m_active_piece.GetCells(), m_active_piece.type);
+    EmitEvent(GameEventType::lock);
+
+    // a piece locked down in the first row ends the game
+    if (m_active_piece.row + m_active_piece.GetShapeInfo().top_row == 0) {
+        m_is_game_over = true;
+        return;
+    }
+    ClearEntirelyOccupiedRows(result);
+    SpawnNextPiece();
+}
+
+void GameCore::ClearEntirelyOccupiedRows(StepResult& result) {
+    m_cleared_rows = m_grid_logic.GetIndexesOfFullyOccupiedRows();
+    if (m_cleared_rows.empty()) {
+        return;
+    }
+    EmitLineClearEvents();
+    if (m_gravity_mode == GravityMode::line) {
+        // Remove the rows from the grid in one pass, the types of the locked
+        // cells above move down along with their rows
+        m_grid_logic.CollapseEntirelyOccupiedRows();
+        AddClearedRowsToScore(m_cleared_rows, result);
+    } else {
+        // Let the groups of blocks above fall on their own. They may fill
+        // further rows, which are cleared in turn until the cascade comes to
+        // rest.
+        while (!m_cleared_rows.empty()) {
+            m_grid_logic.FreeAllEntirelyOccupiedRows();
+            m_grid_logic.ApplyCascadeGravity();
+            AddClearedRowsToScore(m_cleared_rows, result);
+            m_cleared_rows = m_grid_logic.GetIndexesOfFullyOccupiedRows();
+            EmitLineClearEvents();
+        }
+    }
+}
+
+void GameCore::EmitLineClearEvents() {
+    if (m_event_ring == nullptr) {
+        return;
+    }
+    for (int row : m_cleared_rows) {
+        EmitEvent(GameEventType::line_clear, row);
+    }
+}
+
+void GameCore::AddClearedRowsToScore(
+    std::vector<int>& indexes_of_cleared_rows, StepResult& result) {
+    // use the original BPS scoring system, see
+    // https://tetris.wiki/Scoring#Recent_guideline_compatible_games)
+    constexpr std::array<int, 5> kScoresOfLineClears{0, 40, 100, 300, 1200};
+    std::sort(indexes_of_cleared_rows.begin(), indexes_of_cleared_rows.end());
+
+    // Identify single, double, triple or tetris as runs of adjacent rows and
+    // score each of them on its own
+    int score{0};
+    int number_cleared_lines{0};
+    std::size_t run_begin{0};
+    while (run_begin < indexes_of_cleared_rows.size()) {
+        std::size_t run_end{run_begin + 1};
+        while (run_end < indexes_of_cleared_rows.size() &&
+               indexes_of_cleared_rows[run_end] -
+                       indexes_of_cleared_rows[run_end - 1] ==
+                   1) {
+            ++run_end;
+        }
+        // A run of more than four rows can only be filled by a cascade, it
+        // scores a tetris for every four rows plus the remaining rows
+        int line_clear{static_cast<int>(run_end - run_begin)};
+        constexpr int kTetris{4};
+        score += line_clear / kTetris * kScoresOfLineClears[kTetris] +
+                 kScoresOfLineClears[line_clear % kTetris];
+        number_cleared_lines += line_clear;
+        run_begin = run_end;
+    }
+    result.score_gained += score;
+    result.number_cleared_lines += number_cleared_lines;
+    m_score += score;
+    m_number_cleared_lines += number_cleared_lines;
+}
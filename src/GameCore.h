@@ -0,0 +1,225 @@
+#ifndef GAME_CORE_H_
+#define GAME_CORE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GameEvent.h"
+#include "GridLogic.h"
+#include "Piece.h"
+#include "PieceQueue.h"
+#include "PieceRandomizer.h"
+#include "TetrominoGeometry.h"
+
+/// Abstract input of the player, which the game core processes one at a time
+enum class GameInput {
+    none,        // nothing to do, e.g. a tick without input
+    move_left,   // move the active piece one column to the left
+    move_right,  // move the active piece one column to the right
+    move_down,   // move the active piece one row down, locks it at the bottom
+    rotate,      // rotate the active piece clockwise
+    hard_drop,   // drop the active piece as far as possible and lock it
+    new_game     // reset the game, accepted even after game over
+};
+
+/// Outcome of a single step of the game core
+struct StepResult {
+    /// true if the active piece has been locked down during the step. Unless
+    /// the game is over, the next piece has been spawned then.
+    bool is_piece_locked{false};
+    /// number of rows cleared during the step
+    int number_cleared_lines{0};
+    /// score gained during the step
+    int score_gained{0};
+    /// true if the game is over after the step
+    bool is_game_over{false};
+};
+
+/// The GameCore class holds the entire state of a game without any graphics,
+/// i.e. the grid with its locked cells, the active piece, the queue of the
+/// next tetrominoes, the score and whether the game is over. The game only
+/// advances by Step(), which processes one abstract input per call, so that
+/// the game can be driven by a window as well as run headless by a
+/// simulation. The active piece is a Piece placed on the grid, hence a step
+/// never allocates unless rows are cleared.
+class GameCore {
+   public:
+    /// Creates the grid and starts a new game.
+    /// \param number_grid_rows:    Number of rows in the game grid.
+    /// \param number_grid_columns: Number of columns in the game grid.
+    /// \param gravity_mode: How the blocks above cleared rows fall down, see
+    ///                      GravityMode.
+    /// \param piece_randomizer: Generator of the spawned tetromino types.
+    ///                          Pass a randomizer with a fixed seed to
+    ///                          reproduce a game. New games continue its
+    ///                          sequence.
+    /// \param preview_length: Number of tetrominoes waiting in the queue
+    ///                        behind the active piece, see PieceQueue.
+    /// \param event_ring: Ring receiving the events from the start of the
+    ///                    first game on, see SetEventRing().
+    GameCore(int number_grid_rows, int number_grid_columns,
+             GravityMode gravity_mode = GravityMode::line,
+             const PieceRandomizer& piece_randomizer = PieceRandomizer{},
+             int preview_length = PieceQueue::kDefaultLength,
+             GameEventRing* event_ring = nullptr);
+
+    /// Advances the game by one input. A step down which is blocked and a
+    /// hard drop lock the active piece down, clear all rows it fills and
+    /// spawn the next piece. Except for GameInput::new_game, inputs are
+    /// ignored once the game is over.
+    /// \param input: input being processed
+    /// \return what has happened during the step
+    StepResult Step(GameInput input);
+
+    /// Starts a new game by resetting the grid, the scoring and the queue of
+    /// the next tetrominoes and spawning a new active piece.
+    void StartNewGame();
+
+    /// Starts a new game as above, generating its tetrominoes by another
+    /// randomizer, e.g. to play many reproducible games in a row.
+    /// \param piece_randomizer: Generator of the spawned tetromino types.
+    void StartNewGame(const PieceRandomizer& piece_randomizer);
+
+    /// Connects an event ring to which every step emits what has happened,
+    /// i.e. spawns, moves, rotations, lock downs, cleared rows, score changes,
+    /// new games and game over. Emitting never blocks, events are dropped
+    /// while the ring is full. Copies of the game core emit to the same ring,
+    /// so disconnect copies made for a search. The first game has been started
+    /// by the constructor, so pass the ring to the constructor to receive its
+    /// start as well.
+    /// \param event_ring: ring receiving the events, nullptr to disconnect.
+    ///                    The ring is expected to outlive the connection.
+    void SetEventRing(GameEventRing* event_ring) { m_event_ring = event_ring; }
+
+    /// Retrieves the grid. The active piece occupies its cells but, as
+    /// opposed to the locked cells, has no cell type.
+    const GridLogic& GetGridLogic() const { return m_grid_logic; }
+
+    /// Retrieves the active piece. After game over, this is the piece which
+    /// could not be spawned anymore.
+    const Piece& GetActivePiece() const { return m_active_piece; }
+
+    /// Determines by how many rows a hard drop would move the active piece.
+    /// \return the drop distance, 0 after game over
+    int GetGhostDropDistance() const {
+        return m_is_game_over ? 0
+                              : m_grid_logic.GetDropDistance(m_active_piece);
+    }
+
+    /// Retrieves the tetrominoes following the active piece. The first
+    /// element is spawned next.
+    const PieceQueue& GetNextTetrominoes() const { return m_next_tetrominoes; }
+
+    /// Retrieves how the blocks above cleared rows fall down.
+    GravityMode GetGravityMode() const { return m_gravity_mode; }
+
+    /// Retrieves the generator of the tetromino types following the queue.
+    /// A copy of it predicts the types spawned later on.
+    const PieceRandomizer& GetPieceRandomizer() const {
+        return m_piece_randomizer;
+    }
+
+    /// Retrieves the number of pieces spawned since the game start, including
+    /// the active piece.
+    long GetNumberOfSpawnedPieces() const { return m_number_spawned_pieces; }
+
+    /// Retrieves the number of steps since the construction, which is not
+    /// reset by a new game. The next step has this number as its tick.
+    std::uint64_t GetNumberOfTicks() const { return m_number_ticks; }
+
+    /// Computes a hash of the entire game state, i.e. the grid, the active
+    /// piece, the queue, the scoring and the number of ticks. Two games in the
+    /// same state have equal hashes, e.g. to check a replay tick by tick.
+    std::uint64_t ComputeStateHash() const;
+
+    /// Writes the entire game state, i.e. the grid with the types of its
+    /// locked cells, the active piece, the queue, the state of the piece
+    /// randomizer, the scoring and the counters, in a compact binary format.
+    /// The format starts with the magic "TGST", a version byte, the gravity
+    /// mode and the grid dimensions, and the grid takes 4.5 bits per cell, so
+    /// the state of a 20x10 grid fits in about 170 bytes.
+    /// \param buffer: buffer receiving the state, its previous content is
+    ///                replaced and its capacity reused
+    void SaveState(std::vector<std::uint8_t>& buffer) const;
+
+    /// Continues a game from a state written by SaveState() without replaying
+    /// its inputs, e.g. to resume a session or to branch a search from a
+    /// state reached before. The grid is restored in one pass over its rows
+    /// and columns, and nothing is allocated. Within one process, copying a
+    /// GameCore is an alternative which skips the encoding.
+    /// \param data: state written by SaveState()
+    /// \param size: number of bytes of the state
+    /// \return false if the data is not a valid state of a game with the
+    ///         same grid dimensions, e.g. if the occupied cells without a type
+    ///         are not exactly the cells of the active piece, in which case
+    ///         the game is unchanged. The preview length is taken over from
+    ///         the state.
+    bool RestoreState(const std::uint8_t* data, std::size_t size);
+
+    /// Retrieves the score since the game start.
+    int GetScore() const { return m_score; }
+
+    /// Retrieves the number of cleared rows since the game start.
+    int GetNumberOfClearedLines() const { return m_number_cleared_lines; }
+
+    /// Retrieves the information whether the game is over or not.
+    bool IsGameOver() const { return m_is_game_over; }
+
+   private:
+    GridLogic m_grid_logic;
+    GravityMode m_gravity_mode;
+    Piece m_active_piece{};
+    PieceQueue m_next_tetrominoes;
+    long m_number_spawned_pieces{0};
+    std::uint64_t m_number_ticks{0};
+    int m_score{0};
+    int m_number_cleared_lines{0};
+    bool m_is_game_over{false};
+    PieceRandomizer m_piece_randomizer;
+    // rows cleared at once, kept to not allocate on every clear
+    std::vector<int> m_cleared_rows;
+    GameEventRing* m_event_ring{nullptr};
+
+    /// Emits an event about the active piece if an event ring is connected.
+    /// \param type:  type of the event
+    /// \param value: detail of the event, see GameEventType
+    void EmitEvent(GameEventType type, int value = 0) {
+        if (m_event_ring != nullptr) {
+            m_event_ring->TryPush(
+                {m_number_ticks, type, m_active_piece, value});
+        }
+    }
+
+    /// Places the first tetromino of the queue on the grid as the new active
+    /// piece and appends a new tetromino to the queue. The game is over if
+    /// the piece overlaps a locked cell.
+    void SpawnNextPiece();
+
+    /// Locks the active piece down, clears the rows it fills and spawns the
+    /// next piece.
+    /// \param result: result of the current step being updated
+    void LockActivePiece(StepResult& result);
+
+    /// Clears all entirely occupied rows according to the gravity mode.
+    /// \param result: result of the current step being updated
+    void ClearEntirelyOccupiedRows(StepResult& result);
+
+    /// Emits a line clear event for every row in m_cleared_rows.
+    void EmitLineClearEvents();
+
+    /// Adds the score and the number of cleared lines for rows cleared at
+    /// once, using the original BPS scoring system. Every run of adjacent
+    /// rows is scored on its own, e.g. clearing rows 17 and 19 at once
+    /// scores two singles. A run of more than four rows, which only a cascade
+    /// can fill, scores a tetris for every four rows plus the remaining rows.
+    /// \param indexes_of_cleared_rows: indexes of the cleared rows in any
+    ///                                 order, sorted by this method
+    /// \param result:                  result of the current step being
+    ///                                 updated
+    void AddClearedRowsToScore(std::vector<int>& indexes_of_cleared_rows,
+                               StepResult& result);
+};
+
+#endif /* GAME_CORE_H_ */
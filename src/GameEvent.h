@@ -0,0 +1,137 @@
+#ifndef GAME_EVENT_H_
+#define GAME_EVENT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Piece.h"
+
+/// What has happened in a game, see GameEvent
+enum class GameEventType : std::uint8_t {
+    new_game,    // a new game has been started
+    spawn,       // a new active piece has been spawned
+    move,        // the active piece has been moved, value holds the rows of
+                 // a hard drop
+    rotate,      // the active piece has been rotated
+    lock,        // the active piece has been locked down
+    line_clear,  // a row has been cleared, value holds its index
+    score,       // the score has changed, value holds the score gained
+    game_over    // the game is over, value holds the final score
+};
+
+/// Event emitted by a GameCore, see GameCore::SetEventRing()
+struct GameEvent {
+    /// number of steps processed by the game core including the one which
+    /// caused the event, see GameCore::GetNumberOfTicks()
+    std::uint64_t tick{0};
+    GameEventType type{GameEventType::new_game};
+    /// active piece after the event, e.g. the piece which has been moved or
+    /// locked down
+    Piece piece{};
+    /// detail depending on the type, see GameEventType
+    int value{0};
+};
+
+/// The GameEventRing class delivers game events from the thread running a
+/// game to one observer thread, e.g. for statistics, logging or networking.
+/// It is a bounded single-producer single-consumer ring buffer: both sides
+/// only ever wait for an atomic index, and the producer drops events instead
+/// of blocking while the ring is full, so a slow observer never stalls the
+/// game. The indexes of the producer and the consumer are kept on cache lines
+/// of their own, along with a cached copy of the other side's index which
+/// is only refreshed when the ring seems full or empty.
+class GameEventRing {
+   public:
+    /// \param capacity: minimum number of events the ring holds, rounded up
+    ///                  to the next power of two
+    explicit GameEventRing(std::size_t capacity) {
+        std::size_t rounded_capacity{1};
+        while (rounded_capacity < capacity) {
+            rounded_capacity <<= 1;
+        }
+        m_events.resize(rounded_capacity);
+        m_index_mask = rounded_capacity - 1;
+    }
+
+    GameEventRing(const GameEventRing &) = delete;
+    GameEventRing &operator=(const GameEventRing &) = delete;
+
+    /// Retrieves the number of events the ring holds.
+    std::size_t GetCapacity() const { return m_events.size(); }
+
+    /// Appends an event. To be called by the producer thread only.
+    /// \param event: event being appended
+    /// \return false if the ring is full, in which case the event is dropped
+    ///         and counted by GetNumberOfDroppedEvents()
+    bool TryPush(const GameEvent &event) {
+        std::uint64_t write_index{
+            m_write_index.load(std::memory_order_relaxed)};
+        if (write_index - m_cached_read_index == m_events.size()) {
+            m_cached_read_index = m_read_index.load(std::memory_order_acquire);
+            if (write_index - m_cached_read_index == m_events.size()) {
+                m_number_dropped_events.fetch_add(1,
+                                                  std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_events[write_index & m_index_mask] = event;
+        m_write_index.store(write_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Takes the oldest event. To be called by the consumer thread only.
+    /// \param event: receives the event
+    /// \return false if the ring is empty
+    bool TryPop(GameEvent &event) { return PopBatch(&event, 1) == 1; }
+
+    /// Takes up to a number of the oldest events at once, which publishes
+    /// the freed slots to the producer only once. To be called by the
+    /// consumer thread only.
+    /// \param events:            buffer receiving the events
+    /// \param max_number_events: size of the buffer
+    /// \return number of events taken, 0 if the ring is empty
+    std::size_t PopBatch(GameEvent *events, std::size_t max_number_events) {
+        std::uint64_t read_index{m_read_index.load(std::memory_order_relaxed)};
+        if (m_cached_write_index - read_index < max_number_events) {
+            m_cached_write_index =
+                m_write_index.load(std::memory_order_acquire);
+        }
+        std::size_t number_events{static_cast<std::size_t>(
+            m_cached_write_index - read_index)};
+        if (number_events > max_number_events) {
+            number_events = max_number_events;
+        }
+        for (std::size_t index{0}; index < number_events; ++index) {
+            events[index] = m_events[(read_index + index) & m_index_mask];
+        }
+        if (number_events > 0) {
+            m_read_index.store(read_index + number_events,
+                               std::memory_order_release);
+        }
+        return number_events;
+    }
+
+    /// Retrieves the number of events dropped because the ring was full. May
+    /// be called by any thread.
+    std::uint64_t GetNumberOfDroppedEvents() const {
+        return m_number_dropped_events.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::vector<GameEvent> m_events;
+    std::size_t m_index_mask{0};
+
+    // written by the producer, the indexes count all events ever pushed or
+    // popped and are mapped to slots by the mask
+    alignas(64) std::atomic<std::uint64_t> m_write_index{0};
+    std::uint64_t m_cached_read_index{0};
+    std::atomic<std::uint64_t> m_number_dropped_events{0};
+
+    // written by the consumer
+    alignas(64) std::atomic<std::uint64_t> m_read_index{0};
+    std::uint64_t m_cached_write_index{0};
+};
+
+#endif /* GAME_EVENT_H_ */
@@ -1,141 +1,961 @@
 #include "GridLogic.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+
+namespace {
+
+// Shifts a box row mask such that it becomes relative to a box which is
+// located shift columns further to the right
+RowBitsType ShiftBoxRowMask(RowBitsType mask, int shift) {
+    return shift >= 0 ? mask >> shift : mask << -shift;
+}
+
+// Determines whether no other cell is below the given one in the same column
+template <typename CellsType>
+bool IsLowestCellInColumn(const std::pair<int, int> &cell,
+                          const CellsType &cells) {
+    for (const auto &other_cell : cells) {
+        if (other_cell.second == cell.second && other_cell.first > cell.first) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 GridLogic::GridLogic(int number_rows, int number_columns)
     : m_number_rows{number_rows}, m_number_columns{number_columns} {
-    m_occupancy_grid.resize(number_rows);
-    for (auto &row : m_occupancy_grid) {
-        row.resize(number_columns);
-    }
+    assert(number_rows > 0 && number_columns > 0);
+    m_number_words_per_row =
+        (number_columns + kColumnsPerRowWord - 1) / kColumnsPerRowWord;
+    int columns_in_last_word{number_columns % kColumnsPerRowWord};
+    m_last_word_mask = columns_in_last_word == 0
+                           ? ~RowBitsType{0}
+                           : (RowBitsType{1} << columns_in_last_word) - 1;
+    m_occupancy_words.resize(static_cast<std::size_t>(number_rows) *
+                             m_number_words_per_row);
+    m_row_fill_counts.resize(number_rows);
+    m_cell_types.resize(static_cast<std::size_t>(number_rows) * number_columns,
+                        TetrominoType::UNDEFINED);
+    m_row_remap.resize(number_rows);
+    std::size_t number_cells{static_cast<std::size_t>(number_rows) *
+                             number_columns};
+    m_cell_labels.resize(number_cells);
+    m_group_cells.resize(number_cells);
+    m_group_starts.resize(number_cells + 1);
+    m_group_types.resize(number_cells);
+    m_group_support_starts.resize(number_cells + 1);
+    m_group_supports.resize(number_cells);
+    m_group_next_supports.resize(number_cells);
+    m_group_visit_indexes.resize(number_cells);
+    m_group_low_links.resize(number_cells);
+    m_group_call_stack.resize(number_cells);
+    m_group_stack.resize(number_cells);
+    m_is_group_on_stack.resize(number_cells);
+    m_number_words_per_column =
+        (number_rows + kColumnsPerRowWord - 1) / kColumnsPerRowWord;
+    m_column_words.resize(static_cast<std::size_t>(number_columns) *
+                          m_number_words_per_column);
+    m_column_fill_counts.resize(number_columns);
+    m_column_heights.resize(number_columns);
+    m_well_depths.resize(number_columns);
+    RebuildColumnStates();
+    m_indexes_of_fully_occupied_rows.reserve(number_rows);
 }
 
 std::vector<std::vector<bool>> GridLogic::GetOccupancyGrid() const {
-    return m_occupancy_grid;
+    std::vector<std::vector<bool>> occupancy_grid(
+        m_number_rows, std::vector<bool>(m_number_columns));
+    for (int row{0}; row < m_number_rows; ++row) {
+        for (int column{0}; column < m_number_columns; ++column) {
+            occupancy_grid[row][column] = IsCellOccupied(row, column);
+        }
+    }
+    return occupancy_grid;
 }
 
-std::vector<int> GridLogic::GetIndexesOfFullyOccupiedRows() const {
+const std::vector<int> &GridLogic::GetIndexesOfFullyOccupiedRows() const {
     return m_indexes_of_fully_occupied_rows;
 }
 
-bool GridLogic::RequestSpaceOnGrid(TetrominoPositionType current_position,
-                                   TetrominoPositionType target_position) {
-    if (current_position.empty() || target_position.empty()) {
+bool GridLogic::IsRowFull(int row_index) const {
+    return ::IsRowFull(GetRowWords(row_index), m_number_words_per_row,
+                       m_last_word_mask);
+}
+
+bool GridLogic::IsRowEmpty(int row_index) const {
+    return ::IsRowEmpty(GetRowWords(row_index), m_number_words_per_row);
+}
+
+std::size_t GridLogic::GetPackedBitsSize() const {
+    std::size_t number_cells{static_cast<std::size_t>(m_number_rows) *
+                             static_cast<std::size_t>(m_number_columns)};
+    return (number_cells + 7) / 8;
+}
+
+bool GridLogic::ExportPackedBits(std::uint8_t *buffer,
+                                 std::size_t buffer_size) const {
+    if (buffer_size < GetPackedBitsSize()) {
         return false;
     }
+    std::fill(buffer, buffer + GetPackedBitsSize(), 0);
+    std::size_t bit_index{0};
+    for (int row{0}; row < m_number_rows; ++row) {
+        GridRowView row_view{GetRow(row)};
+        for (int column{0}; column < m_number_columns; ++column) {
+            if (row_view.IsCellOccupied(column)) {
+                buffer[bit_index / 8] |=
+                    static_cast<std::uint8_t>(1U << (bit_index % 8));
+            }
+            ++bit_index;
+        }
+    }
+    return true;
+}
 
-    if (current_position.size() != target_position.size()) {
+bool GridLogic::ImportPackedBits(const std::uint8_t *buffer,
+                                 std::size_t buffer_size) {
+    if (buffer_size < GetPackedBitsSize()) {
         return false;
     }
+    std::fill(m_occupancy_words.begin(), m_occupancy_words.end(), 0);
+    std::size_t bit_index{0};
+    for (int row{0}; row < m_number_rows; ++row) {
+        RowBitsType *words{GetRowWords(row)};
+        for (int column{0}; column < m_number_columns; ++column) {
+            if (((buffer[bit_index / 8] >> (bit_index % 8)) & 1U) != 0) {
+                words[column / kColumnsPerRowWord] |=
+                    RowBitsType{1} << (column % kColumnsPerRowWord);
+            }
+            ++bit_index;
+        }
+    }
+    std::fill(m_cell_types.begin(), m_cell_types.end(),
+              TetrominoType::UNDEFINED);
+    RebuildRowStates();
+    RebuildColumnStates();
+    return true;
+}
 
-    bool is_every_coordinate_within_bounds{true};
-    for (const auto &position : target_position) {
-        int pos_x{position.first}, pos_y{position.second};
-        if (pos_x < 0 || pos_x >= m_number_rows || pos_y < 0 ||
-            pos_y >= m_number_columns) {
-            is_every_coordinate_within_bounds = false;
-            break;
+void GridLogic::MoveCells(const TetrominoPositionType &current_position,
+                          const TetrominoPositionType &target_position) {
+    // Free previously occupied positions and occupy the new ones
+    for (const auto &cell : current_position) {
+        FreeCell(cell.first, cell.second);
+        m_cell_types[GetCellIndex(cell.first, cell.second)] =
+            TetrominoType::UNDEFINED;
+    }
+    for (const auto &cell : target_position) {
+        OccupyCell(cell.first, cell.second);
+    }
+
+    // Only rows touched by this request can have changed their fill state
+    for (const auto &cell : current_position) {
+        UpdateIndexesOfFullyOccupiedRows(cell.first);
+    }
+    for (const auto &cell : target_position) {
+        UpdateIndexesOfFullyOccupiedRows(cell.first);
+    }
+}
+
+MoveResult GridLogic::TryPlace(TetrominoType type, Orientation orientation,
+                               int row, int column) {
+    return TryMoveSquares(nullptr, row, column, GetShapeInfo(type, orientation),
+                          row, column);
+}
+
+MoveResult GridLogic::TryTranslate(TetrominoType type, Orientation orientation,
+                                   int row, int column, int delta_row,
+                                   int delta_column) {
+    const TetrominoShapeInfo &info{GetShapeInfo(type, orientation)};
+    return TryMoveSquares(&info, row, column, info, row + delta_row,
+                          column + delta_column);
+}
+
+MoveResult GridLogic::TryRotate(TetrominoType type, Orientation orientation,
+                                int row, int column) {
+    return TryMoveSquares(
+        &GetShapeInfo(type, orientation), row, column,
+        GetShapeInfo(type, GetNextClockwiseOrientation(orientation)), row,
+        column);
+}
+
+MoveResult GridLogic::TryTranslate(Piece &piece, int delta_row,
+                                   int delta_column) {
+    MoveResult result{TryTranslate(piece.type, piece.orientation, piece.row,
+                                   piece.column, delta_row, delta_column)};
+    if (result == MoveResult::success) {
+        piece = piece.Translated(delta_row, delta_column);
+    }
+    return result;
+}
+
+MoveResult GridLogic::TryRotate(Piece &piece) {
+    MoveResult result{
+        TryRotate(piece.type, piece.orientation, piece.row, piece.column)};
+    if (result == MoveResult::success) {
+        piece = piece.RotatedClockwise();
+    }
+    return result;
+}
+
+int GridLogic::GetDropDistance(TetrominoType type, Orientation orientation,
+                               int row, int column) const {
+    const TetrominoShapeInfo &info{GetShapeInfo(type, orientation)};
+    int drop_distance{m_number_rows};
+    for (int box_column{info.left_column}; box_column <= info.right_column;
+         ++box_column) {
+        drop_distance = std::min(
+            drop_distance, GetFreeRowsBelow(row + info.lowest_rows[box_column],
+                                            column + box_column));
+    }
+    return drop_distance;
+}
+
+int GridLogic::GetDropDistance(const TetrominoPositionType &position) const {
+    int drop_distance{m_number_rows};
+    for (const auto &cell : position) {
+        if (IsLowestCellInColumn(cell, position)) {
+            drop_distance = std::min(drop_distance,
+                                     GetFreeRowsBelow(cell.first, cell.second));
         }
     }
+    return drop_distance;
+}
 
-    bool is_request_successfull{false};
-    if (is_every_coordinate_within_bounds) {
-        try {
-            // Check free positions in the desired direction
-            bool is_occupied{false};
+bool GridLogic::TestPlacements(const PlacementCandidate *candidates,
+                               std::size_t number_candidates,
+                               std::uint64_t *result_bitmap,
+                               std::size_t bitmap_size) const {
+    if (bitmap_size < GetPlacementBitmapSize(number_candidates)) {
+        return false;
+    }
+    std::fill_n(result_bitmap, GetPlacementBitmapSize(number_candidates), 0);
 
-            // First, identify target cells which do not overlap with the
-            // current position's cells
-            TetrominoPositionType disjoint_target_cells;
-            for (const auto &target_cell : target_position) {
-                bool is_target_disjoint{true};
-                for (const auto &current_cell : current_position) {
-                    is_target_disjoint &= (current_cell != target_cell);
-                }
-                if (is_target_disjoint) {
-                    disjoint_target_cells.push_back(target_cell);
+    // The box of a tetromino may start up to three columns left of the grid.
+    // So the box columns are split into blocks of 64 starting at column -3,
+    // and the fitting columns of a block are reused as long as consecutive
+    // candidates share type, orientation, row and block.
+    constexpr int kFirstBoxColumn{1 - kNumberSquaresPerTetromino};
+    const PlacementCandidate *cached_candidate{nullptr};
+    int cached_first_column{};
+    RowBitsType fitting_columns{0};
+    for (std::size_t index{0}; index < number_candidates; ++index) {
+        const PlacementCandidate &candidate{candidates[index]};
+        if (candidate.column < kFirstBoxColumn) {
+            continue;
+        }
+        int first_column{candidate.column -
+                         (candidate.column - kFirstBoxColumn) %
+                             kColumnsPerRowWord};
+        if (cached_candidate == nullptr ||
+            cached_candidate->type != candidate.type ||
+            cached_candidate->orientation != candidate.orientation ||
+            cached_candidate->row != candidate.row ||
+            cached_first_column != first_column) {
+            fitting_columns = GetFittingColumns(
+                candidate.type, candidate.orientation, candidate.row,
+                first_column);
+            cached_candidate = &candidate;
+            cached_first_column = first_column;
+        }
+        if (((fitting_columns >> (candidate.column - first_column)) & 1U) !=
+            0) {
+            result_bitmap[index / 64] |= std::uint64_t{1} << (index % 64);
+        }
+    }
+    return true;
+}
+
+void GridLogic::FreeAllEntirelyOccupiedRows() {
+    for (int row_index : m_indexes_of_fully_occupied_rows) {
+        std::fill_n(GetRowWords(row_index), m_number_words_per_row, 0);
+        std::fill_n(m_cell_types.begin() + GetCellIndex(row_index, 0),
+                    m_number_columns, TetrominoType::UNDEFINED);
+        m_row_fill_counts[row_index] = 0;
+        FreeFullRowInColumns(row_index, false);
+    }
+    m_indexes_of_fully_occupied_rows.clear();
+    UpdateColumnHeights();
+}
+
+const std::vector<int> &GridLogic::CollapseEntirelyOccupiedRows() {
+    // walk from bottom to top and move every row which is not fully occupied
+    // to the lowest row which has not been written yet
+    int target_row{m_number_rows - 1};
+    for (int row{m_number_rows - 1}; row >= 0; --row) {
+        if (m_row_fill_counts[row] == m_number_columns) {
+            m_row_remap[row] = -1;
+            continue;
+        }
+        m_row_remap[row] = target_row;
+        if (target_row != row) {
+            std::copy_n(GetRowWords(row), m_number_words_per_row,
+                        GetRowWords(target_row));
+            std::copy_n(m_cell_types.begin() + GetCellIndex(row, 0),
+                        m_number_columns,
+                        m_cell_types.begin() + GetCellIndex(target_row, 0));
+            m_row_fill_counts[target_row] = m_row_fill_counts[row];
+        }
+        --target_row;
+    }
+
+    // the rows above the moved ones are empty
+    std::fill_n(m_occupancy_words.begin(),
+                static_cast<std::size_t>(target_row + 1) *
+                    m_number_words_per_row,
+                0);
+    std::fill_n(m_cell_types.begin(), GetCellIndex(target_row + 1, 0),
+                TetrominoType::UNDEFINED);
+    std::fill_n(m_row_fill_counts.begin(), target_row + 1, 0);
+    m_indexes_of_fully_occupied_rows.clear();
+
+    // remove the same rows from the transposed grid, from the top to the
+    // bottom, so the index of a removed row is not changed by the ones above
+    for (int row{0}; row < m_number_rows; ++row) {
+        if (m_row_remap[row] < 0) {
+            FreeFullRowInColumns(row, true);
+        }
+    }
+    UpdateColumnHeights();
+    return m_row_remap;
+}
+
+bool GridLogic::ApplyCascadeGravity() {
+    // Every group is dropped once, after all groups below it in any of its
+    // columns have come to rest, so it falls onto their final cells. Only
+    // interlocked groups, which lie below each other in different columns,
+    // e.g. a hook reaching around another group, depend on each other and
+    // are dropped in turns until none of them falls any further.
+    int number_groups{LabelConnectedGroups()};
+    BuildGroupSupports(number_groups);
+    bool is_any_group_fallen{false};
+    std::fill_n(m_group_visit_indexes.begin(), number_groups, -1);
+    int number_visited_groups{0};
+    int stack_size{0};
+    for (int root{0}; root < number_groups; ++root) {
+        if (m_group_visit_indexes[root] >= 0) {
+            continue;
+        }
+        // iterative depth-first search of Tarjan's algorithm, which completes
+        // the strongly connected components of the groups in the order of
+        // their supports, i.e. the supporting components first
+        int call_depth{0};
+        m_group_call_stack[call_depth++] = root;
+        m_group_visit_indexes[root] = m_group_low_links[root] =
+            number_visited_groups++;
+        m_group_next_supports[root] = m_group_support_starts[root];
+        m_group_stack[stack_size++] = root;
+        m_is_group_on_stack[root] = true;
+        while (call_depth > 0) {
+            int group{m_group_call_stack[call_depth - 1]};
+            if (m_group_next_supports[group] <
+                m_group_support_starts[group + 1]) {
+                int support{
+                    m_group_supports[m_group_next_supports[group]++]};
+                if (m_group_visit_indexes[support] < 0) {
+                    m_group_call_stack[call_depth++] = support;
+                    m_group_visit_indexes[support] =
+                        m_group_low_links[support] = number_visited_groups++;
+                    m_group_next_supports[support] =
+                        m_group_support_starts[support];
+                    m_group_stack[stack_size++] = support;
+                    m_is_group_on_stack[support] = true;
+                } else if (m_is_group_on_stack[support]) {
+                    m_group_low_links[group] =
+                        std::min(m_group_low_links[group],
+                                 m_group_visit_indexes[support]);
                 }
+                continue;
+            }
+            --call_depth;
+            if (call_depth > 0) {
+                int caller{m_group_call_stack[call_depth - 1]};
+                m_group_low_links[caller] = std::min(
+                    m_group_low_links[caller], m_group_low_links[group]);
             }
+            if (m_group_low_links[group] != m_group_visit_indexes[group]) {
+                continue;
+            }
+            // the component consists of the group and the groups above it on
+            // the stack
+            int component_begin{stack_size};
+            do {
+                m_is_group_on_stack[m_group_stack[--component_begin]] = false;
+            } while (m_group_stack[component_begin] != group);
+            if (DropGroups(component_begin, stack_size)) {
+                is_any_group_fallen = true;
+            }
+            stack_size = component_begin;
+        }
+    }
+    RebuildRowStates();
+    return is_any_group_fallen;
+}
 
-            // In case of no overlapping between current and target position
-            // because
-            //  - either tetromino was placed initially or
-            //  - it was placed at the same place it has been before or
-            //  - it was moved so far such that there is no overlap
-            // check whether the target position is occupied.
-            if (disjoint_target_cells.empty()) {
-                for (const auto &cell : target_position) {
-                    int row{cell.first}, column{cell.second};
-                    is_occupied |= m_occupancy_grid.at(row).at(column);
-                }
+void GridLogic::LockCells(const TetrominoPositionType &position,
+                          TetrominoType type) {
+    for (const auto &cell : position) {
+        m_cell_types[GetCellIndex(cell.first, cell.second)] = type;
+    }
+}
+
+std::uint64_t GridLogic::ComputeStateHash() const {
+    std::uint64_t hash{
+        CombineHash(static_cast<std::uint64_t>(m_number_rows),
+                    static_cast<std::uint64_t>(m_number_columns))};
+    for (RowBitsType word : m_occupancy_words) {
+        hash = CombineHash(hash, word);
+    }
+    // pack the types of eight cells into one value, every type fits in a byte
+    std::uint64_t packed_types{0};
+    for (std::size_t index{0}; index < m_cell_types.size(); ++index) {
+        packed_types = (packed_types << 8) |
+                       static_cast<std::uint64_t>(m_cell_types[index]);
+        if (index % 8 == 7) {
+            hash = CombineHash(hash, packed_types);
+            packed_types = 0;
+        }
+    }
+    return CombineHash(hash, packed_types);
+}
+
+void GridLogic::FreeEntireGrid() {
+    std::fill(m_occupancy_words.begin(), m_occupancy_words.end(), 0);
+    std::fill(m_cell_types.begin(), m_cell_types.end(),
+              TetrominoType::UNDEFINED);
+    std::fill(m_row_fill_counts.begin(), m_row_fill_counts.end(), 0);
+    m_indexes_of_fully_occupied_rows.clear();
+    std::fill(m_column_words.begin(), m_column_words.end(), 0);
+    std::fill(m_column_fill_counts.begin(), m_column_fill_counts.end(), 0);
+    std::fill(m_column_heights.begin(), m_column_heights.end(), 0);
+    std::fill(m_well_depths.begin(), m_well_depths.end(), 0);
+    m_number_holes = 0;
+}
+
+void GridLogic::OccupyCell(int row, int column) {
+    OccupyRowBits(row, column, 1);
+}
+
+void GridLogic::FreeCell(int row, int column) { FreeRowBits(row, column, 1); }
+
+RowBitsType GridLogic::GetRowWindow(int row, int column) const {
+    if (column < 0) {
+        return GetRowWindow(row, 0) << -column;
+    }
+    int word{column / kColumnsPerRowWord};
+    int shift{column % kColumnsPerRowWord};
+    if (word >= m_number_words_per_row) {
+        return 0;
+    }
+    const RowBitsType *words{GetRowWords(row)};
+    RowBitsType window{words[word] >> shift};
+    if (shift != 0 && word + 1 < m_number_words_per_row) {
+        window |= words[word + 1] << (kColumnsPerRowWord - shift);
+    }
+    return window;
+}
+
+RowBitsType GridLogic::GetColumnRangeMask(int column) const {
+    int number_columns_in_grid{m_number_columns - column};
+    if (number_columns_in_grid <= 0) {
+        return 0;
+    }
+    RowBitsType mask{number_columns_in_grid >= kColumnsPerRowWord
+                         ? ~RowBitsType{0}
+                         : (RowBitsType{1} << number_columns_in_grid) - 1};
+    if (column < 0) {
+        mask &= column <= -kColumnsPerRowWord ? 0 : ~RowBitsType{0} << -column;
+    }
+    return mask;
+}
+
+RowBitsType GridLogic::GetFittingColumns(TetrominoType type,
+                                         Orientation orientation, int row,
+                                         int first_column) const {
+    const TetrominoShapeInfo &info{GetShapeInfo(type, orientation)};
+    if (row + info.top_row < 0 || row + info.bottom_row >= m_number_rows) {
+        return 0;
+    }
+    RowBitsType fitting_columns{~RowBitsType{0}};
+    for (int box_row{info.top_row}; box_row <= info.bottom_row; ++box_row) {
+        for (int box_column{info.left_column}; box_column <= info.right_column;
+             ++box_column) {
+            if (((info.row_masks[box_row] >> box_column) & 1U) == 0) {
+                continue;
             }
-            // In case of overlapping between current and target position
-            // check only for disjoint cells whether they are all occupied.
-            else {
-                for (const auto &cell : disjoint_target_cells) {
-                    int row{cell.first}, column{cell.second};
-                    is_occupied |= m_occupancy_grid.at(row).at(column);
-                }
+            int square_column{first_column + box_column};
+            fitting_columns &= ~GetRowWindow(row + box_row, square_column) &
+                               GetColumnRangeMask(square_column);
+        }
+    }
+    return fitting_columns;
+}
+
+void GridLogic::OccupyRowBits(int row, int column, RowBitsType bits) {
+    if (column < 0) {
+        bits >>= -column;
+        column = 0;
+    }
+    int word{column / kColumnsPerRowWord};
+    int shift{column % kColumnsPerRowWord};
+    OccupyWordBits(row, word, bits << shift);
+    if (shift != 0 && (bits >> (kColumnsPerRowWord - shift)) != 0) {
+        OccupyWordBits(row, word + 1, bits >> (kColumnsPerRowWord - shift));
+    }
+}
+
+void GridLogic::FreeRowBits(int row, int column, RowBitsType bits) {
+    if (column < 0) {
+        bits >>= -column;
+        column = 0;
+    }
+    int word{column / kColumnsPerRowWord};
+    int shift{column % kColumnsPerRowWord};
+    FreeWordBits(row, word, bits << shift);
+    if (shift != 0 && (bits >> (kColumnsPerRowWord - shift)) != 0) {
+        FreeWordBits(row, word + 1, bits >> (kColumnsPerRowWord - shift));
+    }
+}
+
+void GridLogic::OccupyWordBits(int row, int word, RowBitsType bits) {
+    RowBitsType &row_word{GetRowWords(row)[word]};
+    RowBitsType newly_occupied_bits{bits & ~row_word};
+    row_word |= newly_occupied_bits;
+    m_row_fill_counts[row] += __builtin_popcountll(newly_occupied_bits);
+    for (; newly_occupied_bits != 0;
+         newly_occupied_bits &= newly_occupied_bits - 1) {
+        OccupyColumnCell(row, word * kColumnsPerRowWord +
+                                  __builtin_ctzll(newly_occupied_bits));
+    }
+}
+
+void GridLogic::FreeWordBits(int row, int word, RowBitsType bits) {
+    RowBitsType &row_word{GetRowWords(row)[word]};
+    RowBitsType newly_freed_bits{bits & row_word};
+    row_word &= ~newly_freed_bits;
+    m_row_fill_counts[row] -= __builtin_popcountll(newly_freed_bits);
+    for (; newly_freed_bits != 0; newly_freed_bits &= newly_freed_bits - 1) {
+        FreeColumnCell(row, word * kColumnsPerRowWord +
+                                __builtin_ctzll(newly_freed_bits));
+    }
+}
+
+std::size_t GridLogic::GetPackedCellsSize() const {
+    return GetPackedBitsSize() + (m_cell_types.size() + 1) / 2;
+}
+
+bool GridLogic::ExportPackedCells(std::uint8_t *buffer,
+                                  std::size_t buffer_size) const {
+    if (buffer_size < GetPackedCellsSize()) {
+        return false;
+    }
+    ExportPackedBits(buffer, buffer_size);
+    std::uint8_t *types{buffer + GetPackedBitsSize()};
+    std::fill(types, buffer + GetPackedCellsSize(), 0);
+    for (std::size_t index{0}; index < m_cell_types.size(); ++index) {
+        types[index / 2] |= static_cast<std::uint8_t>(
+            static_cast<unsigned>(m_cell_types[index]) << (4 * (index % 2)));
+    }
+    return true;
+}
+
+bool GridLogic::ImportPackedCells(const std::uint8_t *buffer,
+                                  std::size_t buffer_size) {
+    if (buffer_size < GetPackedCellsSize()) {
+        return false;
+    }
+    // check all cells before changing anything, the packed bits and the
+    // types are both in row-major order
+    const std::uint8_t *types{buffer + GetPackedBitsSize()};
+    constexpr unsigned kUndefined{
+        static_cast<unsigned>(TetrominoType::UNDEFINED)};
+    for (std::size_t index{0}; index < m_cell_types.size(); ++index) {
+        bool is_occupied{((buffer[index / 8] >> (index % 8)) & 1U) != 0};
+        unsigned type{(types[index / 2] >> (4 * (index % 2))) & 0xFU};
+        if (type > kUndefined || (type != kUndefined && !is_occupied)) {
+            return false;
+        }
+    }
+    ImportPackedBits(buffer, buffer_size);
+    for (std::size_t index{0}; index < m_cell_types.size(); ++index) {
+        m_cell_types[index] = static_cast<TetrominoType>(
+            (types[index / 2] >> (4 * (index % 2))) & 0xFU);
+    }
+    return true;
+}
+
+bool GridLogic::CopyWordsTo(RowBitsType *words, int number_rows,
+                            int number_columns) const {
+    if (number_rows != m_number_rows || number_columns != m_number_columns) {
+        return false;
+    }
+    std::copy(m_occupancy_words.begin(), m_occupancy_words.end(), words);
+    return true;
+}
+
+bool GridLogic::CopyWordsFrom(const RowBitsType *words, int number_rows,
+                              int number_columns) {
+    if (number_rows != m_number_rows || number_columns != m_number_columns) {
+        return false;
+    }
+    std::copy_n(words, m_occupancy_words.size(), m_occupancy_words.begin());
+    std::fill(m_cell_types.begin(), m_cell_types.end(),
+              TetrominoType::UNDEFINED);
+    RebuildRowStates();
+    RebuildColumnStates();
+    return true;
+}
+
+void GridLogic::RebuildRowStates() {
+    m_indexes_of_fully_occupied_rows.clear();
+    for (int row{m_number_rows - 1}; row >= 0; --row) {
+        int fill_count{0};
+        if (!IsRowEmpty(row)) {
+            const RowBitsType *words{GetRowWords(row)};
+            for (int word{0}; word < m_number_words_per_row; ++word) {
+                fill_count += __builtin_popcountll(words[word]);
             }
+        }
+        m_row_fill_counts[row] = fill_count;
+        if (IsRowFull(row)) {
+            m_indexes_of_fully_occupied_rows.push_back(row);
+        }
+    }
+}
 
-            if (!is_occupied) {
-                // Free previously occupied positions
-                for (const auto &current_cell : current_position) {
-                    int current_cell_row{current_cell.first};
-                    int current_cell_column{current_cell.second};
-                    m_occupancy_grid.at(current_cell_row)
-                        .at(current_cell_column) = false;
-                }
+void GridLogic::OccupyColumnCell(int row, int column) {
+    GetColumnWords(column)[row / kColumnsPerRowWord] |=
+        RowBitsType{1} << (row % kColumnsPerRowWord);
+    ++m_column_fill_counts[column];
+    --m_number_holes;
+    SetColumnHeight(column,
+                    std::max(m_column_heights[column], m_number_rows - row));
+}
 
-                // Occupy new positions
-                for (const auto &target_cell : target_position) {
-                    int target_cell_row{target_cell.first};
-                    int target_cell_column{target_cell.second};
-                    m_occupancy_grid.at(target_cell_row)
-                        .at(target_cell_column) = true;
-                }
+void GridLogic::FreeColumnCell(int row, int column) {
+    GetColumnWords(column)[row / kColumnsPerRowWord] &=
+        ~(RowBitsType{1} << (row % kColumnsPerRowWord));
+    --m_column_fill_counts[column];
+    ++m_number_holes;
+    if (m_number_rows - row == m_column_heights[column]) {
+        // the topmost cell has been freed, so search for the next one below
+        SetColumnHeight(column, m_number_rows - FindTopmostOccupiedRow(
+                                                    column, row + 1));
+    }
+}
 
-                // put indexes of fully occupied rows in grid
-                // from bottom to top into m_indexes_of_fully_occupied_rows
-                int row_idx{m_number_rows - 1};
-                m_indexes_of_fully_occupied_rows.clear();
-                for (auto it = m_occupancy_grid.rbegin();
-                     it != m_occupancy_grid.rend(); ++it) {
-                    bool is_entire_row_occupied{true};
-                    for (const bool is_cell_occupied : (*it)) {
-                        is_entire_row_occupied &= is_cell_occupied;
-                    }
-                    if (is_entire_row_occupied) {
-                        m_indexes_of_fully_occupied_rows.push_back(row_idx);
+int GridLogic::GetFreeRowsBelow(int row, int column) const {
+    return FindTopmostOccupiedRow(column, row + 1) - row - 1;
+}
+
+int GridLogic::FindTopmostOccupiedRow(int column, int first_row) const {
+    if (first_row >= m_number_rows) {
+        return m_number_rows;
+    }
+    const RowBitsType *words{GetColumnWords(column)};
+    int word{first_row / kColumnsPerRowWord};
+    RowBitsType bits{words[word] &
+                     (~RowBitsType{0} << (first_row % kColumnsPerRowWord))};
+    while (bits == 0) {
+        if (++word == m_number_words_per_column) {
+            return m_number_rows;
+        }
+        bits = words[word];
+    }
+    return word * kColumnsPerRowWord + __builtin_ctzll(bits);
+}
+
+void GridLogic::SetColumnHeight(int column, int height) {
+    // The holes of a column are its height minus its fill count. The callers
+    // have accounted for the changed fill count already.
+    m_number_holes += height - m_column_heights[column];
+    m_column_heights[column] = height;
+    UpdateWellDepth(column);
+    if (column > 0) {
+        UpdateWellDepth(column - 1);
+    }
+    if (column + 1 < m_number_columns) {
+        UpdateWellDepth(column + 1);
+    }
+}
+
+void GridLogic::UpdateWellDepth(int column) {
+    int left_height{column > 0 ? m_column_heights[column - 1]
+                               : m_number_rows};
+    int right_height{column + 1 < m_number_columns
+                         ? m_column_heights[column + 1]
+                         : m_number_rows};
+    m_well_depths[column] = std::max(
+        0, std::min(left_height, right_height) - m_column_heights[column]);
+}
+
+void GridLogic::FreeFullRowInColumns(int row, bool is_removed) {
+    int row_word{row / kColumnsPerRowWord};
+    int shift{row % kColumnsPerRowWord};
+    RowBitsType row_bit{RowBitsType{1} << shift};
+    RowBitsType rows_above_mask{row_bit - 1};
+    for (int column{0}; column < m_number_columns; ++column) {
+        RowBitsType *words{GetColumnWords(column)};
+        if (!is_removed) {
+            words[row_word] &= ~row_bit;
+        } else {
+            // the rows above move one row down, i.e. one bit up, and the
+            // highest bit of a word moves into the next word
+            RowBitsType carry{0};
+            for (int word{0}; word < row_word; ++word) {
+                RowBitsType next_carry{words[word] >>
+                                       (kColumnsPerRowWord - 1)};
+                words[word] = (words[word] << 1) | carry;
+                carry = next_carry;
+            }
+            RowBitsType rows_below{words[row_word] & ~rows_above_mask &
+                                   ~row_bit};
+            words[row_word] =
+                rows_below | ((words[row_word] & rows_above_mask) << 1) |
+                carry;
+        }
+        // the freed cell counts as a hole until the height is updated
+        --m_column_fill_counts[column];
+        ++m_number_holes;
+    }
+}
+
+void GridLogic::UpdateColumnHeights() {
+    for (int column{0}; column < m_number_columns; ++column) {
+        SetColumnHeight(column,
+                        m_number_rows - FindTopmostOccupiedRow(column, 0));
+    }
+}
+
+void GridLogic::RebuildColumnStates() {
+    std::fill(m_column_words.begin(), m_column_words.end(), 0);
+    std::fill(m_column_fill_counts.begin(), m_column_fill_counts.end(), 0);
+    ForEachOccupiedCell([this](int row, int column) {
+        GetColumnWords(column)[row / kColumnsPerRowWord] |=
+            RowBitsType{1} << (row % kColumnsPerRowWord);
+        ++m_column_fill_counts[column];
+    });
+    m_number_holes = 0;
+    for (int column{0}; column < m_number_columns; ++column) {
+        m_column_heights[column] =
+            m_number_rows - FindTopmostOccupiedRow(column, 0);
+        m_number_holes += GetNumberOfHolesInColumn(column);
+    }
+    for (int column{0}; column < m_number_columns; ++column) {
+        UpdateWellDepth(column);
+    }
+}
+
+MoveResult GridLogic::TryMoveSquares(const TetrominoShapeInfo *source,
+                                     int source_row, int source_column,
+                                     const TetrominoShapeInfo &target,
+                                     int target_row, int target_column) {
+    // Check the grid bounds first. Leaving the grid at the sides or at the top
+    // is reported as wall, leaving it at the bottom as floor.
+    if (target_row + target.top_row < 0 ||
+        target_column + target.left_column < 0 ||
+        target_column + target.right_column >= m_number_columns) {
+        return MoveResult::wall;
+    }
+    if (target_row + target.bottom_row >= m_number_rows) {
+        return MoveResult::floor;
+    }
+
+    // Check the target cells against the grid while ignoring the cells
+    // occupied by the tetromino itself
+    for (int box_row{target.top_row}; box_row <= target.bottom_row;
+         ++box_row) {
+        int row{target_row + box_row};
+        int source_box_row{row - source_row};
+        RowBitsType own_bits{0};
+        if (source != nullptr && source_box_row >= 0 &&
+            source_box_row < kNumberSquaresPerTetromino) {
+            own_bits = ShiftBoxRowMask(source->row_masks[source_box_row],
+                                       target_column - source_column);
+        }
+        if ((GetRowWindow(row, target_column) & ~own_bits &
+             target.row_masks[box_row]) != 0) {
+            return MoveResult::stack;
+        }
+    }
+
+    // Move the squares
+    if (source != nullptr) {
+        for (int box_row{source->top_row}; box_row <= source->bottom_row;
+             ++box_row) {
+            FreeRowBits(source_row + box_row, source_column,
+                        source->row_masks[box_row]);
+        }
+    }
+    for (int box_row{target.top_row}; box_row <= target.bottom_row;
+         ++box_row) {
+        OccupyRowBits(target_row + box_row, target_column,
+                      target.row_masks[box_row]);
+    }
+    if (source != nullptr) {
+        for (int box_row{source->top_row}; box_row <= source->bottom_row;
+             ++box_row) {
+            UpdateIndexesOfFullyOccupiedRows(source_row + box_row);
+        }
+    }
+    for (int box_row{target.top_row}; box_row <= target.bottom_row;
+         ++box_row) {
+        UpdateIndexesOfFullyOccupiedRows(target_row + box_row);
+    }
+    return MoveResult::success;
+}
+
+int GridLogic::LabelConnectedGroups() {
+    std::fill(m_cell_labels.begin(), m_cell_labels.end(), -1);
+    int number_groups{0};
+    int number_labeled_cells{0};
+    for (int row{m_number_rows - 1}; row >= 0; --row) {
+        if (m_row_fill_counts[row] == 0) {
+            continue;
+        }
+        for (int column{0}; column < m_number_columns; ++column) {
+            int first_cell{static_cast<int>(GetCellIndex(row, column))};
+            if (!IsCellOccupied(row, column) ||
+                m_cell_labels[first_cell] >= 0) {
+                continue;
+            }
+
+            // breadth-first flood fill which uses the group's segment of
+            // m_group_cells as its queue
+            m_group_starts[number_groups] = number_labeled_cells;
+            m_cell_labels[first_cell] = number_groups;
+            m_group_cells[number_labeled_cells++] = first_cell;
+            for (int next{m_group_starts[number_groups]};
+                 next < number_labeled_cells; ++next) {
+                int cell_row{m_group_cells[next] / m_number_columns};
+                int cell_column{m_group_cells[next] % m_number_columns};
+                const std::pair<int, int> neighbours[]{
+                    {cell_row + 1, cell_column},
+                    {cell_row - 1, cell_column},
+                    {cell_row, cell_column - 1},
+                    {cell_row, cell_column + 1}};
+                for (const auto &neighbour : neighbours) {
+                    if (!IsWithinBounds(neighbour) ||
+                        !IsCellOccupied(neighbour.first, neighbour.second)) {
+                        continue;
                     }
-                    --row_idx;
-                    if (row_idx < 0) {
-                        break;
+                    int neighbour_cell{static_cast<int>(
+                        GetCellIndex(neighbour.first, neighbour.second))};
+                    if (m_cell_labels[neighbour_cell] < 0) {
+                        m_cell_labels[neighbour_cell] = number_groups;
+                        m_group_cells[number_labeled_cells++] = neighbour_cell;
                     }
                 }
-
-                is_request_successfull = true;
             }
-        } catch (std::out_of_range const &e) {
-            std::cerr << e.what() << '\n';
+            ++number_groups;
         }
     }
+    m_group_starts[number_groups] = number_labeled_cells;
+    return number_groups;
+}
 
-    return is_request_successfull;
+void GridLogic::BuildGroupSupports(int number_groups) {
+    // A group is supported by the group of the next occupied cell below each
+    // of its cells, if that cell belongs to another group. So every cell adds
+    // at most one support, which are counted first and stored per group
+    // afterwards.
+    std::fill_n(m_group_support_starts.begin(), number_groups + 1, 0);
+    for (int pass{0}; pass < 2; ++pass) {
+        for (int column{0}; column < m_number_columns; ++column) {
+            int group_below{-1};
+            for (int row{m_number_rows - 1}; row >= 0; --row) {
+                int group{m_cell_labels[GetCellIndex(row, column)]};
+                if (group < 0) {
+                    continue;
+                }
+                if (group_below >= 0 && group_below != group) {
+                    if (pass == 0) {
+                        ++m_group_support_starts[group + 1];
+                    } else {
+                        m_group_supports[m_group_next_supports[group]++] =
+                            group_below;
+                    }
+                }
+                group_below = group;
+            }
+        }
+        if (pass == 0) {
+            for (int group{0}; group < number_groups; ++group) {
+                m_group_support_starts[group + 1] +=
+                    m_group_support_starts[group];
+                m_group_next_supports[group] = m_group_support_starts[group];
+            }
+        }
+    }
 }
 
-void GridLogic::FreeAllEntirelyOccupiedRows() {
-    for (int row_index : m_indexes_of_fully_occupied_rows) {
-        // Free entire row
-        auto &column = m_occupancy_grid.at(row_index);
-        for (auto it = column.begin(); it != column.end();) {
-            *it = false;
-            ++it;
+bool GridLogic::DropGroups(int begin, int end) {
+    bool is_any_group_fallen{false};
+    bool is_group_fallen_in_turn{true};
+    while (is_group_fallen_in_turn) {
+        is_group_fallen_in_turn = false;
+        for (int index{begin}; index < end; ++index) {
+            if (DropGroup(m_group_stack[index]) > 0) {
+                is_group_fallen_in_turn = true;
+                is_any_group_fallen = true;
+            }
+        }
+        // a single group has fallen as far as it can at once
+        if (end - begin == 1) {
+            break;
         }
     }
-    m_indexes_of_fully_occupied_rows.clear();
+    return is_any_group_fallen;
 }
 
-void GridLogic::FreeEntireGrid() {
-    for (auto &row : m_occupancy_grid) {
-        std::fill(row.begin(), row.end(), false);
+int GridLogic::DropGroup(int group) {
+    int first{m_group_starts[group]};
+    int last{m_group_starts[group + 1]};
+
+    // the group must not block itself, so it is lifted off the grid first
+    for (int index{first}; index < last; ++index) {
+        FreeCell(m_group_cells[index] / m_number_columns,
+                 m_group_cells[index] % m_number_columns);
+    }
+    int drop_distance{m_number_rows};
+    for (int index{first}; index < last; ++index) {
+        int row{m_group_cells[index] / m_number_columns};
+        int column{m_group_cells[index] % m_number_columns};
+        drop_distance = std::min(drop_distance, GetFreeRowsBelow(row, column));
     }
-}
\ No newline at end of file
+
+    // the cells of a group may overlap their own target cells, so all types
+    // are picked up before any of them is put down again
+    int cell_offset{drop_distance * m_number_columns};
+    for (int index{first}; index < last; ++index) {
+        m_group_types[index] = m_cell_types[m_group_cells[index]];
+        m_cell_types[m_group_cells[index]] = TetrominoType::UNDEFINED;
+    }
+    for (int index{first}; index < last; ++index) {
+        m_group_cells[index] += cell_offset;
+        m_cell_types[m_group_cells[index]] = m_group_types[index];
+        OccupyCell(m_group_cells[index] / m_number_columns,
+                   m_group_cells[index] % m_number_columns);
+    }
+    return drop_distance;
+}
+
+void GridLogic::UpdateIndexesOfFullyOccupiedRows(int row) {
+    // the indexes are sorted in descending order, i.e. from bottom to top
+    auto position = std::lower_bound(m_indexes_of_fully_occupied_rows.begin(),
+                                     m_indexes_of_fully_occupied_rows.end(),
+                                     row, std::greater<int>());
+    bool is_listed{position != m_indexes_of_fully_occupied_rows.end() &&
+                   *position == row};
+    bool is_full{m_row_fill_counts[row] == m_number_columns};
+    if (is_full && !is_listed) {
+        m_indexes_of_fully_occupied_rows.insert(position, row);
+    } else if (!is_full && is_listed) {
+        m_indexes_of_fully_occupied_rows.erase(position);
+    }
+}
@@ -1,11 +1,93 @@
 #ifndef GRID_LOGIC_H_
 #define GRID_LOGIC_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "BoardState.h"
 #include "IGridLogic.h"
+#include "Piece.h"
+#include "RowScan.h"
+#include "TetrominoGeometry.h"
+
+/// Outcome of a request to place, move or rotate a tetromino on the grid
+enum class MoveResult {
+    success,  // the request has been granted
+    wall,     // a square would leave the grid to the left, right or top
+    floor,    // a square would leave the grid at the bottom
+    stack     // a square would overlap a cell occupied by another tetromino
+};
+
+/// Mixes a value into a hash, e.g. to hash the state of a game field by
+/// field. The result depends on the order in which values are mixed in.
+/// \param hash:  hash of the values mixed in so far
+/// \param value: value being mixed in
+/// \return hash of all values including the new one
+inline std::uint64_t CombineHash(std::uint64_t hash, std::uint64_t value) {
+    // finalizer of SplitMix64 applied to the sum, which spreads every bit of
+    // the value over the entire hash
+    hash += value + 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+/// How the blocks above cleared rows fall down
+enum class GravityMode {
+    line,    // the rows above a cleared row move down as a whole, see
+             // GridLogic::CollapseEntirelyOccupiedRows()
+    cascade  // every group of connected blocks falls as far as it can, see
+             // GridLogic::ApplyCascadeGravity()
+};
+
+/// Candidate position of a tetromino for GridLogic::TestPlacements(). The
+/// position is given by the top left corner of the 4x4 box the tetromino
+/// rotates in, see kTetrominoSquareOffsets.
+struct PlacementCandidate {
+    TetrominoType type;
+    Orientation orientation;
+    int row;
+    int column;
+};
+
+/// Non-owning, read-only view of one row of the logical grid. The view does
+/// not copy any cell and stays valid as long as the grid it has been retrieved
+/// from is alive. Its content reflects all later changes of the grid.
+class GridRowView {
+   public:
+    /// Creates a view on the bitmask words of one row
+    /// \param words:          pointer to the first word of the row
+    /// \param number_columns: number of columns in the row
+    GridRowView(const RowBitsType *words, int number_columns)
+        : m_words{words}, m_number_columns{number_columns} {}
+
+    /// Determines whether the cell in the specified column is occupied
+    bool IsCellOccupied(int column) const {
+        return ((m_words[column / kColumnsPerRowWord] >>
+                 (column % kColumnsPerRowWord)) &
+                1U) != 0;
+    }
+
+    /// Retrieves the number of columns (cells) in the row
+    int GetNumberOfColumns() const { return m_number_columns; }
+
+    /// Retrieves the number of bitmask words the row consists of
+    int GetNumberOfWords() const {
+        return (m_number_columns + kColumnsPerRowWord - 1) /
+               kColumnsPerRowWord;
+    }
+
+    /// Retrieves the bitmask words of the row. Bit n of word w corresponds to
+    /// the cell in column w * 64 + n.
+    const RowBitsType *GetWords() const { return m_words; }
+
+   private:
+    const RowBitsType *m_words;
+    int m_number_columns;
+};
 
 /// The GridLogic class keeps track of the playfield, which is a grid into which
 /// the tetrominoes are falling. So the class determines whether the active
@@ -13,11 +95,17 @@
 /// also referred to as the logical grid. The x-axis is vertical and counts
 /// positive from top to bottom whereas the y-axis is horizontal counting
 /// positive from left to right.
-class GridLogic : public IGridLogic {
+/// Internally, every row is stored as a bitmask of one or more 64-bit words
+/// such that collision checks, occupying and freeing of cells boil down to a
+/// few AND/OR operations. Boards may be arbitrarily wide and tall. The former
+/// vector-of-vectors implementation is still available as VectorGridLogic.
+/// The class is final and checks requests of RequestSpaceOnGrid() inline, so
+/// calls on a GridLogic itself are bound at compile time.
+class GridLogic final : public IGridLogic {
    public:
     /// Constructs a playfield as a grid
     /// \param number_rows:    number of rows in the grid being constructed
-    /// \param number_columns: number of columns in the grid eing constructed
+    /// \param number_columns: number of columns in the grid being constructed
     GridLogic(int number_rows, int number_columns);
 
     /// Retrieves the grid
@@ -25,9 +113,168 @@ class GridLogic : public IGridLogic {
     std::vector<std::vector<bool>> GetOccupancyGrid() const;
 
     /// Retrieves the number of those rows in the grid which are fully occupied
-    /// by tetrominoes.
+    /// by tetrominoes. The returned reference is invalidated by the next change
+    /// of the grid.
     /// \return: a list of fully occupied rows
-    std::vector<int> GetIndexesOfFullyOccupiedRows() const;
+    const std::vector<int> &GetIndexesOfFullyOccupiedRows() const;
+
+    /// Retrieves the number of rows in the grid
+    int GetNumberOfRows() const { return m_number_rows; }
+
+    /// Retrieves the number of columns in the grid
+    int GetNumberOfColumns() const { return m_number_columns; }
+
+    /// Determines whether the specified cell is occupied without copying the
+    /// grid. The indexes are expected to be within the grid bounds.
+    bool IsCellOccupied(int row_index, int column_index) const {
+        return GetRow(row_index).IsCellOccupied(column_index);
+    }
+
+    /// Retrieves a read-only view of one row without copying it.
+    /// \param row_index: index of the row, 0 corresponds to the top row
+    GridRowView GetRow(int row_index) const {
+        return GridRowView{GetRowWords(row_index), m_number_columns};
+    }
+
+    /// Determines whether all cells of a row are occupied by scanning its
+    /// bitmask words with the fastest SIMD instructions the CPU supports.
+    bool IsRowFull(int row_index) const;
+
+    /// Determines whether all cells of a row are free by scanning its bitmask
+    /// words with the fastest SIMD instructions the CPU supports.
+    bool IsRowEmpty(int row_index) const;
+
+    /// Calls visitor(row_index, column_index, is_occupied) for every cell of
+    /// the grid, row by row from top to bottom and from left to right.
+    template <typename Visitor>
+    void ForEachCell(Visitor &&visitor) const {
+        for (int row{0}; row < m_number_rows; ++row) {
+            GridRowView row_view{GetRow(row)};
+            for (int column{0}; column < m_number_columns; ++column) {
+                visitor(row, column, row_view.IsCellOccupied(column));
+            }
+        }
+    }
+
+    /// Calls visitor(row_index, column_index) for every occupied cell of the
+    /// grid only. Empty cells are skipped word by word.
+    template <typename Visitor>
+    void ForEachOccupiedCell(Visitor &&visitor) const {
+        for (int row{0}; row < m_number_rows; ++row) {
+            if (m_row_fill_counts[row] == 0) {
+                continue;
+            }
+            const RowBitsType *words{GetRowWords(row)};
+            for (int word{0}; word < m_number_words_per_row; ++word) {
+                RowBitsType bits{words[word]};
+                while (bits != 0) {
+                    visitor(row, word * kColumnsPerRowWord +
+                                     __builtin_ctzll(bits));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    /// Records the type of a tetromino which has been locked down, so that its
+    /// cells can be drawn in its color without keeping the tetromino object
+    /// alive. The types move along with their rows when fully occupied rows
+    /// are collapsed and are forgotten when the rows are freed.
+    /// \param position: cells of the locked tetromino, expected to be within
+    ///                  the grid bounds
+    /// \param type:     type of the locked tetromino
+    void LockCells(const TetrominoPositionType &position, TetrominoType type);
+
+    /// Retrieves the type of the tetromino locked down on the specified cell.
+    /// The indexes are expected to be within the grid bounds.
+    /// \return the type recorded by LockCells(), or UNDEFINED if the cell is
+    ///         free or occupied by a tetromino which has not been locked yet
+    TetrominoType GetCellType(int row_index, int column_index) const {
+        if (!IsCellOccupied(row_index, column_index)) {
+            return TetrominoType::UNDEFINED;
+        }
+        return m_cell_types[GetCellIndex(row_index, column_index)];
+    }
+
+    /// Calls visitor(row_index, column_index, type) for every cell on which a
+    /// tetromino has been locked down, see LockCells(). Empty cells are
+    /// skipped word by word.
+    template <typename Visitor>
+    void ForEachLockedCell(Visitor &&visitor) const {
+        ForEachOccupiedCell([this, &visitor](int row, int column) {
+            TetrominoType type{m_cell_types[GetCellIndex(row, column)]};
+            if (type != TetrominoType::UNDEFINED) {
+                visitor(row, column, type);
+            }
+        });
+    }
+
+    /// Retrieves the number of bytes required by ExportPackedBits().
+    std::size_t GetPackedBitsSize() const;
+
+    /// Writes the occupancy of all cells as densely packed bits into a buffer
+    /// provided by the caller. Cell (r/c) is stored in bit (r * n + c) % 8 of
+    /// byte (r * n + c) / 8 where n is the number of columns.
+    /// \param buffer:      buffer receiving the packed bits
+    /// \param buffer_size: size of the buffer in bytes
+    /// \return false if the buffer is too small, true otherwise
+    bool ExportPackedBits(std::uint8_t *buffer, std::size_t buffer_size) const;
+
+    /// Replaces the occupancy of all cells by densely packed bits in the
+    /// format written by ExportPackedBits(). The fill state of every row is
+    /// rebuilt afterwards.
+    /// \param buffer:      buffer holding the packed bits
+    /// \param buffer_size: size of the buffer in bytes
+    /// \return false if the buffer is too small, in which case the grid is
+    ///         unchanged, true otherwise
+    bool ImportPackedBits(const std::uint8_t *buffer, std::size_t buffer_size);
+
+    /// Retrieves the number of bytes required by ExportPackedCells().
+    std::size_t GetPackedCellsSize() const;
+
+    /// Writes the occupancy and the types of all cells into a buffer provided
+    /// by the caller: the packed bits of ExportPackedBits() are followed by
+    /// four bits per cell in the same order holding the type of a locked cell
+    /// or UNDEFINED, see LockCells().
+    /// \param buffer:      buffer receiving the packed cells
+    /// \param buffer_size: size of the buffer in bytes
+    /// \return false if the buffer is too small, true otherwise
+    bool ExportPackedCells(std::uint8_t *buffer, std::size_t buffer_size) const;
+
+    /// Replaces the occupancy and the types of all cells by packed cells in
+    /// the format written by ExportPackedCells(). The fully occupied rows and
+    /// the column properties are rebuilt afterwards.
+    /// \param buffer:      buffer holding the packed cells
+    /// \param buffer_size: size of the buffer in bytes
+    /// \return false if the buffer is too small or holds a type of a free
+    ///         cell, in which case the grid is unchanged, true otherwise.
+    ///         Occupied cells without a type are taken over as cells of a
+    ///         tetromino which has not been locked yet, it is up to the
+    ///         caller to check them against its pieces in play.
+    bool ImportPackedCells(const std::uint8_t *buffer, std::size_t buffer_size);
+
+    /// Copies the occupancy of all cells into a fixed-size snapshot. This is
+    /// a plain copy of the row bitmasks without any allocation. The types of
+    /// locked cells are not part of the snapshot.
+    /// \param state: snapshot receiving the occupancy
+    /// \return false if the dimensions of the snapshot differ from the ones
+    ///         of the grid, in which case the snapshot is unchanged
+    template <int NumberRows, int NumberColumns>
+    bool SaveState(BoardState<NumberRows, NumberColumns> &state) const {
+        return CopyWordsTo(state.words.data(), NumberRows, NumberColumns);
+    }
+
+    /// Replaces the occupancy of all cells by the one of a snapshot. The row
+    /// bitmasks are copied without any allocation, and the fully occupied rows
+    /// as well as the column properties are rebuilt afterwards. The types of
+    /// locked cells are reset.
+    /// \param state: snapshot holding the occupancy
+    /// \return false if the dimensions of the snapshot differ from the ones
+    ///         of the grid, in which case the grid is unchanged
+    template <int NumberRows, int NumberColumns>
+    bool RestoreState(const BoardState<NumberRows, NumberColumns> &state) {
+        return CopyWordsFrom(state.words.data(), NumberRows, NumberColumns);
+    }
 
     /// Requests specified cells in the grid. If any requested cell is already
     /// occupied by former requests, the current request is rejected. In all
@@ -35,17 +282,195 @@ class GridLogic : public IGridLogic {
     /// as occupied/booked. This method is supposed to be used by the single
     /// tetrominoes which in turn are requested to be moved either by the player
     /// via the keyboard event in any direction or periodically by the
-    /// controller in the down direction.
+    /// controller in the down direction. Like all positions, both hold at
+    /// most four cells, see IGridLogic::RequestSpaceOnGrid().
     /// \param current_position: Position from which to move the figure.
     /// \param target_position:  Position to which to move the figure.
     /// \return true when request has been granted, false in case of rejection.
-    bool RequestSpaceOnGrid(TetrominoPositionType current_position,
-                            TetrominoPositionType target_position) override;
+    bool RequestSpaceOnGrid(
+        const TetrominoPositionType &current_position,
+        const TetrominoPositionType &target_position) override {
+        if (!IsSpaceAvailable(current_position, target_position)) {
+            return false;
+        }
+        MoveCells(current_position, target_position);
+        return true;
+    }
+
+    /// Places a tetromino on the grid. Position, orientation and movement of a
+    /// tetromino are described by its type, its orientation and the position
+    /// of the top left corner of the 4x4 box it rotates in, see
+    /// kTetrominoSquareOffsets. As opposed to RequestSpaceOnGrid(), this method
+    /// and its siblings TryTranslate() and TryRotate() do not need the cells
+    /// of the tetromino, never throw and report the reason of a rejected
+    /// request.
+    /// \param type:        type of the tetromino, must not be UNDEFINED
+    /// \param orientation: orientation of the tetromino
+    /// \param row:         row of the box's top left corner
+    /// \param column:      column of the box's top left corner
+    /// \return success when the squares have been marked as occupied,
+    ///         otherwise the reason of the rejection.
+    MoveResult TryPlace(TetrominoType type, Orientation orientation, int row,
+                        int column);
+
+    /// Moves a tetromino which has been placed on the grid before by the
+    /// specified number of rows and columns. The cells of the tetromino at its
+    /// current position do not block the movement.
+    /// \param type:         type of the tetromino, must not be UNDEFINED
+    /// \param orientation:  orientation of the tetromino
+    /// \param row:          current row of the box's top left corner
+    /// \param column:       current column of the box's top left corner
+    /// \param delta_row:    number of rows to move, positive is downwards
+    /// \param delta_column: number of columns to move, positive is rightwards
+    /// \return success when the tetromino has been moved, otherwise the reason
+    ///         of the rejection. The grid is unchanged in case of a rejection.
+    MoveResult TryTranslate(TetrominoType type, Orientation orientation,
+                            int row, int column, int delta_row,
+                            int delta_column);
+
+    /// Rotates a tetromino which has been placed on the grid before clockwise
+    /// within its box. The cells of the tetromino at its current position do
+    /// not block the rotation.
+    /// \param type:        type of the tetromino, must not be UNDEFINED
+    /// \param orientation: current orientation of the tetromino
+    /// \param row:         row of the box's top left corner
+    /// \param column:      column of the box's top left corner
+    /// \return success when the tetromino has been rotated, otherwise the
+    ///         reason of the rejection. The grid is unchanged in case of a
+    ///         rejection.
+    MoveResult TryRotate(TetrominoType type, Orientation orientation, int row,
+                         int column);
+
+    /// Places a piece on the grid, see TryPlace() above.
+    MoveResult TryPlace(const Piece &piece) {
+        return TryPlace(piece.type, piece.orientation, piece.row,
+                        piece.column);
+    }
+
+    /// Moves a piece which has been placed on the grid before, see
+    /// TryTranslate() above. The piece is updated to its new position on
+    /// success and left unchanged otherwise.
+    MoveResult TryTranslate(Piece &piece, int delta_row, int delta_column);
+
+    /// Rotates a piece which has been placed on the grid before clockwise,
+    /// see TryRotate() above. The piece is updated to its new orientation on
+    /// success and left unchanged otherwise.
+    MoveResult TryRotate(Piece &piece);
+
+    /// Retrieves the height of the stack in a column, i.e. the number of rows
+    /// from the bottom of the grid up to and including the topmost occupied
+    /// cell of the column. The height of an empty column is 0.
+    int GetColumnHeight(int column_index) const {
+        return m_column_heights[column_index];
+    }
+
+    /// Retrieves the heights of all columns, see GetColumnHeight(). The
+    /// returned reference reflects all later changes of the grid.
+    const std::vector<int> &GetColumnHeights() const {
+        return m_column_heights;
+    }
+
+    /// Retrieves the number of holes in a column. A hole is a free cell which
+    /// has at least one occupied cell above it in the same column.
+    int GetNumberOfHolesInColumn(int column_index) const {
+        return m_column_heights[column_index] -
+               m_column_fill_counts[column_index];
+    }
+
+    /// Retrieves the number of holes in the entire grid
+    int GetNumberOfHoles() const { return m_number_holes; }
+
+    /// Retrieves the depth of the well in a column, i.e. by how many rows the
+    /// lower one of its neighbouring columns is higher than the column
+    /// itself. The walls of the grid count as neighbours as high as the grid.
+    /// The depth is 0 if the column is not lower than both neighbours.
+    int GetWellDepth(int column_index) const {
+        return m_well_depths[column_index];
+    }
+
+    /// Determines by how many rows a tetromino can drop until it lands on the
+    /// stack or on the floor. Only the lowest square of the tetromino in each
+    /// column is looked at, and the cell below it is found directly in the
+    /// transposed grid, so the query does not depend on the drop height.
+    /// Whether the tetromino itself has been placed on the grid or not does
+    /// not matter.
+    /// \param type:        type of the tetromino, must not be UNDEFINED
+    /// \param orientation: orientation of the tetromino
+    /// \param row:         row of the box's top left corner
+    /// \param column:      column of the box's top left corner
+    /// \return number of free rows below the tetromino. The squares are
+    ///         expected to be within the grid.
+    int GetDropDistance(TetrominoType type, Orientation orientation, int row,
+                        int column) const;
+
+    /// Determines by how many rows a tetromino given by the positions of its
+    /// squares can drop, see the overload above.
+    /// \param position: squares of the tetromino, expected to be within the
+    ///                  grid
+    int GetDropDistance(const TetrominoPositionType &position) const;
+
+    /// Determines by how many rows a piece can drop, see the overloads above.
+    int GetDropDistance(const Piece &piece) const {
+        return GetDropDistance(piece.type, piece.orientation, piece.row,
+                               piece.column);
+    }
+
+    /// Retrieves the number of words required by TestPlacements() to store
+    /// the results for a certain number of candidates.
+    static std::size_t GetPlacementBitmapSize(std::size_t number_candidates) {
+        return (number_candidates + 63) / 64;
+    }
+
+    /// Determines for many candidate positions at once whether a tetromino
+    /// could be placed there, i.e. whether all its squares are within the
+    /// grid and free. The grid is not changed. The free columns of a row are
+    /// determined for 64 box columns at a time, so candidates sharing type,
+    /// orientation and row are cheapest to test when they are adjacent in the
+    /// list.
+    /// \param candidates:        candidate positions to be tested
+    /// \param number_candidates: number of candidates
+    /// \param result_bitmap:     receives the results, bit i % 64 of word
+    ///                           i / 64 is set when candidate i fits
+    /// \param bitmap_size:       size of the bitmap in words
+    /// \return false if the bitmap is too small, true otherwise
+    bool TestPlacements(const PlacementCandidate *candidates,
+                        std::size_t number_candidates,
+                        std::uint64_t *result_bitmap,
+                        std::size_t bitmap_size) const;
 
     /// Frees all lines which are fully occupied by tetrominoes. This method is
     /// supposed to be used when fully occupied lines are cleared.
     void FreeAllEntirelyOccupiedRows();
 
+    /// Removes all fully occupied rows and shifts the rows above them down in
+    /// a single pass over the grid, so that the grid looks as if the removed
+    /// rows have never existed. Empty rows are inserted at the top.
+    /// \return: row remap table with one entry per row in the grid before the
+    ///          collapse. The entry of a removed row is -1, every other entry
+    ///          holds the index the row has been moved to. The returned
+    ///          reference is valid until the next collapse.
+    const std::vector<int> &CollapseEntirelyOccupiedRows();
+
+    /// Lets every group of connected occupied cells fall as far as it can.
+    /// Cells are connected when they share an edge, so a group may consist
+    /// of several tetrominoes or of parts of one. The groups are labeled by a
+    /// flood fill and ordered by the groups below them, so every group is
+    /// dropped once onto groups which have already come to rest, in time
+    /// linear in the number of cells. Only groups interlocked with each
+    /// other, e.g. a hook reaching around another group, are dropped in
+    /// turns until none of them falls any further.
+    /// The types of the locked cells fall along with them. This method is
+    /// supposed to be used after FreeAllEntirelyOccupiedRows() while no
+    /// tetromino is moving on the grid. Rows filled by the falling groups are
+    /// reported by GetIndexesOfFullyOccupiedRows() afterwards.
+    /// \return true if any group has fallen, false otherwise
+    bool ApplyCascadeGravity();
+
+    /// Computes a hash of the occupancy of all cells and the types of the
+    /// locked cells. Grids with equal dimensions and equal cells have equal
+    /// hashes, e.g. to check that a replayed game reaches the same state.
+    std::uint64_t ComputeStateHash() const;
+
     /// Frees all cells unconditionally. This method is supposed to be used in
     /// case of game over to reset the game.
     void FreeEntireGrid();
@@ -53,9 +478,13 @@ class GridLogic : public IGridLogic {
    private:
     int m_number_columns{};
     int m_number_rows{};
+    int m_number_words_per_row{};
+
+    // bits of the last word of each row which correspond to a column
+    RowBitsType m_last_word_mask{};
 
     // vector containing the indexes of entirely occupied rows in
-    // m_occupancy_grid in the order from bottom to top, i.e.
+    // the grid in the order from bottom to top, i.e.
     // m_indexes_of_fully_occupied_rows[0] corresponds to the lowest entirely
     // occupied row whereas m_indexes_of_fully_occupied_rows[size-1] corresponds
     // to the most top entirely occupied row
@@ -64,12 +493,241 @@ class GridLogic : public IGridLogic {
     // The grid is rectangular, i.e. it consists of m x n cells, where m is the
     // number of rows and n is the number of columns. Columns are numbered from
     // left to right, and rows - unconventionally - from top to bottom. Each
-    // grid cell is clearly specified by a coordinate. So the grid cell at the
-    // top left has the coordinate (0/0), while the grid cell at the bottom
-    // right has the coordinate (m-1 / n-1). Consequently, the grid cell at the
-    // bottom left is identified by the coordinate (m-1/0), while the grid cell
-    // at the top right is defined by the coordinate (0 / n-1).
-    std::vector<std::vector<bool>> m_occupancy_grid{};
+    // row consists of w = m_number_words_per_row consecutive words, so row r
+    // starts at m_occupancy_words[r * w] and the cell (r/c) is occupied when
+    // bit c % 64 of word c / 64 of that row is set. So the grid cell at the
+    // top left corresponds to bit 0 of m_occupancy_words[0]. Bits beyond the
+    // last column are always zero.
+    std::vector<RowBitsType> m_occupancy_words{};
+
+    // number of occupied cells in each row. The counts are updated cell by
+    // cell whenever a request is granted, so only the rows touched by a
+    // request need to be checked for being fully occupied afterwards.
+    std::vector<int> m_row_fill_counts{};
+
+    // type of the tetromino locked down on each cell in row-major order, see
+    // LockCells(). Cells which have not been locked hold UNDEFINED.
+    std::vector<TetrominoType> m_cell_types{};
+
+    // row remap table of the latest collapse, see
+    // CollapseEntirelyOccupiedRows()
+    std::vector<int> m_row_remap{};
+
+    // Scratch buffers of ApplyCascadeGravity(), sized once on construction.
+    // m_cell_labels holds the group of each cell in row-major order or -1 for
+    // free cells. The cells of group g are stored as row-major indexes in
+    // m_group_cells[m_group_starts[g]] to m_group_cells[m_group_starts[g+1]],
+    // and m_group_types keeps their types while the group falls.
+    std::vector<int> m_cell_labels{};
+    std::vector<int> m_group_cells{};
+    std::vector<int> m_group_starts{};
+    std::vector<TetrominoType> m_group_types{};
+    // The groups supporting group g, i.e. holding the next occupied cell
+    // below one of its cells, are m_group_supports[m_group_support_starts[g]]
+    // to m_group_supports[m_group_support_starts[g+1]]. The remaining buffers
+    // hold the state of the search for the order of the supports.
+    std::vector<int> m_group_support_starts{};
+    std::vector<int> m_group_supports{};
+    std::vector<int> m_group_next_supports{};
+    std::vector<int> m_group_visit_indexes{};
+    std::vector<int> m_group_low_links{};
+    std::vector<int> m_group_call_stack{};
+    std::vector<int> m_group_stack{};
+    std::vector<bool> m_is_group_on_stack{};
+
+    // Transposed copy of the grid which keeps the column properties cheap to
+    // update. Each column consists of m_number_words_per_column consecutive
+    // words, and the cell (r/c) is occupied when bit r % 64 of word r / 64 of
+    // column c is set. So the topmost occupied cell of a column is its lowest
+    // set bit.
+    int m_number_words_per_column{};
+    std::vector<RowBitsType> m_column_words{};
+
+    // number of occupied cells, stack height and well depth of each column as
+    // well as the total number of holes, see GetColumnHeight(),
+    // GetNumberOfHoles() and GetWellDepth()
+    std::vector<int> m_column_fill_counts{};
+    std::vector<int> m_column_heights{};
+    std::vector<int> m_well_depths{};
+    int m_number_holes{};
+
+    bool IsWithinBounds(const std::pair<int, int> &cell) const {
+        return cell.first >= 0 && cell.first < m_number_rows &&
+               cell.second >= 0 && cell.second < m_number_columns;
+    }
+
+    static bool IsCellOfPosition(const std::pair<int, int> &cell,
+                                 const TetrominoPositionType &position) {
+        for (const auto &position_cell : position) {
+            if (position_cell == cell) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Collision check of RequestSpaceOnGrid(), which does not change the grid
+    bool IsSpaceAvailable(const TetrominoPositionType &current_position,
+                          const TetrominoPositionType &target_position) const {
+        if (current_position.empty() || target_position.empty()) {
+            return false;
+        }
+
+        if (current_position.size() != target_position.size()) {
+            return false;
+        }
+
+        for (const auto &cell : target_position) {
+            if (!IsWithinBounds(cell)) {
+                return false;
+            }
+        }
+        for (const auto &cell : current_position) {
+            if (!IsWithinBounds(cell)) {
+                return false;
+            }
+        }
+
+        // In case every target cell overlaps with the current position's cells
+        // because
+        //  - either tetromino was placed initially or
+        //  - it was placed at the same place it has been before
+        // all target cells are checked against the grid as it is. Otherwise,
+        // target cells overlapping with the current position are considered
+        // free such that only cells occupied by other tetrominoes can block
+        // the request.
+        bool is_target_subset_of_current{true};
+        for (const auto &target_cell : target_position) {
+            if (!IsCellOfPosition(target_cell, current_position)) {
+                is_target_subset_of_current = false;
+                break;
+            }
+        }
+
+        for (const auto &cell : target_position) {
+            if ((is_target_subset_of_current ||
+                 !IsCellOfPosition(cell, current_position)) &&
+                IsCellOccupied(cell.first, cell.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Frees the current cells and occupies the target cells of a request
+    // granted by IsSpaceAvailable()
+    void MoveCells(const TetrominoPositionType &current_position,
+                   const TetrominoPositionType &target_position);
+    void OccupyCell(int row, int column);
+    void FreeCell(int row, int column);
+
+    std::size_t GetCellIndex(int row, int column) const {
+        return static_cast<std::size_t>(row) * m_number_columns + column;
+    }
+
+    const RowBitsType *GetRowWords(int row) const {
+        return &m_occupancy_words[static_cast<std::size_t>(row) *
+                                  m_number_words_per_row];
+    }
+    RowBitsType *GetRowWords(int row) {
+        return &m_occupancy_words[static_cast<std::size_t>(row) *
+                                  m_number_words_per_row];
+    }
+
+    // Bits of a row are addressed through a 64-bit window starting at a
+    // certain column, so that bit n of the window corresponds to the cell in
+    // column + n. The window may straddle two words of the row and may start
+    // left of the grid (column > -64), the corresponding bits read as free.
+    RowBitsType GetRowWindow(int row, int column) const;
+    void OccupyRowBits(int row, int column, RowBitsType bits);
+    void FreeRowBits(int row, int column, RowBitsType bits);
+    void OccupyWordBits(int row, int word, RowBitsType bits);
+    void FreeWordBits(int row, int word, RowBitsType bits);
+
+    // Bit n of the result is set when column + n is within the grid
+    RowBitsType GetColumnRangeMask(int column) const;
+
+    // Bit n of the result is set when the tetromino fits with the left column
+    // of its box at first_column + n
+    RowBitsType GetFittingColumns(TetrominoType type, Orientation orientation,
+                                  int row, int first_column) const;
+
+    // Copy the bitmask words of all rows to or from a buffer laid out like
+    // m_occupancy_words if the dimensions match
+    bool CopyWordsTo(RowBitsType *words, int number_rows,
+                     int number_columns) const;
+    bool CopyWordsFrom(const RowBitsType *words, int number_rows,
+                       int number_columns);
+
+    // Recomputes the fill count and the fully occupied state of every row
+    void RebuildRowStates();
+
+    const RowBitsType *GetColumnWords(int column) const {
+        return &m_column_words[static_cast<std::size_t>(column) *
+                               m_number_words_per_column];
+    }
+    RowBitsType *GetColumnWords(int column) {
+        return &m_column_words[static_cast<std::size_t>(column) *
+                               m_number_words_per_column];
+    }
+
+    // Keep the transposed grid and the column properties up to date when a
+    // single cell has been occupied or freed
+    void OccupyColumnCell(int row, int column);
+    void FreeColumnCell(int row, int column);
+
+    // Retrieves the index of the topmost occupied row of a column starting
+    // the search at first_row, or the number of rows if there is none
+    int FindTopmostOccupiedRow(int column, int first_row) const;
+
+    // Retrieves the number of free rows below a cell
+    int GetFreeRowsBelow(int row, int column) const;
+
+    // Sets the height of a column and updates the hole count and the well
+    // depths affected by the new height
+    void SetColumnHeight(int column, int height);
+    void UpdateWellDepth(int column);
+
+    // Frees a fully occupied row in the transposed grid, or removes it by
+    // moving the rows above one row down. The heights of the columns have to
+    // be updated afterwards by UpdateColumnHeights().
+    void FreeFullRowInColumns(int row, bool is_removed);
+
+    // Updates the heights of all columns from the transposed grid along with
+    // the hole count and the well depths
+    void UpdateColumnHeights();
+
+    // Recomputes the transposed grid and all column properties from the rows,
+    // e.g. once the entire grid has been replaced
+    void RebuildColumnStates();
+
+    // Common implementation of TryPlace(), TryTranslate() and TryRotate().
+    // source is nullptr if the tetromino is not on the grid yet.
+    MoveResult TryMoveSquares(const TetrominoShapeInfo *source, int source_row,
+                              int source_column,
+                              const TetrominoShapeInfo &target, int target_row,
+                              int target_column);
+
+    // Labels the groups of connected occupied cells in the order of a scan
+    // from the bottom row to the top and returns the number of groups
+    int LabelConnectedGroups();
+
+    // Determines the groups supporting each group labeled by
+    // LabelConnectedGroups(), see m_group_supports
+    void BuildGroupSupports(int number_groups);
+
+    // Drops the groups m_group_stack[begin] to m_group_stack[end], which
+    // support each other, in turns until none of them falls any further and
+    // returns whether any of them has fallen
+    bool DropGroups(int begin, int end);
+
+    // Moves a group labeled by LabelConnectedGroups() down as far as it can
+    // and returns the number of rows it has fallen
+    int DropGroup(int group);
+
+    // Adds the row to or removes it from m_indexes_of_fully_occupied_rows
+    // depending on its current fill count.
+    void UpdateIndexesOfFullyOccupiedRows(int row);
 };
 
 #endif /* GRID_LOGIC_H_ */
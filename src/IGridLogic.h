@@ -3,15 +3,28 @@
 
 #include <iostream>
 #include <utility>
-#include <vector>
 
-using TetrominoPositionType = std::vector<std::pair<int, int>>;
+#include "FixedCapacityVector.h"
+
+/// Cells (row/column) occupied by a tetromino. A tetromino never consists of
+/// more than four squares, so the cells are stored inline and passing a
+/// position around does not allocate.
+using TetrominoPositionType = FixedCapacityVector<std::pair<int, int>, 4>;
 
 class IGridLogic {
    public:
     virtual ~IGridLogic() = default;
-    virtual bool RequestSpaceOnGrid(TetrominoPositionType current_position,
-                                    TetrominoPositionType target_position) = 0;
+
+    /// Requests the cells of a target position instead of the ones of a
+    /// current position. Both positions hold at most four cells, the capacity
+    /// of TetrominoPositionType, so larger sets of cells have to be requested
+    /// in several calls.
+    /// \param current_position: cells from which to move the figure
+    /// \param target_position:  cells to which to move the figure
+    /// \return true when the request has been granted, false otherwise
+    virtual bool RequestSpaceOnGrid(
+        const TetrominoPositionType &current_position,
+        const TetrominoPositionType &target_position) = 0;
 };
 
 #endif /* I_GRID_LOGIC_H_ */
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "InputPolicy.h"
+
+#include <algorithm>
+#include <array>
+
+#include "PieceRandomizer.h"
+
+GameInput RandomInputPolicy::GetNextInput(const GameCore & /*game_core*/) {
+    constexpr std::array<GameInput, 8> kInputs{
+        GameInput::move_left, GameInput::move_left,  GameInput::move_right,
+        GameInput::move_right, GameInput::rotate,    GameInput::rotate,
+        GameInput::move_down, GameInput::hard_drop};
+    return kInputs[NextSplitMix64(m_state) >> 61];
+}
+
+void GreedyInputPolicy::Reset(std::uint64_t /*seed*/) {
+    m_has_target = false;
+    m_last_input = GameInput::none;
+}
+
+GameInput GreedyInputPolicy::GetNextInput(const GameCore &game_core) {
+    const Piece &piece{game_core.GetActivePiece()};
+    bool is_new_piece{!m_has_target || game_core.GetNumberOfSpawnedPieces() !=
+                                            m_number_spawned_pieces};
+    if (is_new_piece) {
+        m_number_spawned_pieces = game_core.GetNumberOfSpawnedPieces();
+        PlanTarget(game_core);
+    }
+
+    GameInput input{GameInput::hard_drop};
+    bool is_blocked{!is_new_piece && piece == m_last_piece &&
+                    m_last_input != GameInput::move_down};
+    if (is_blocked) {
+        // a rotation may be blocked by the top of the grid, so let the piece
+        // fall a row before trying again, and drop it where it is otherwise
+        input = m_last_input == GameInput::rotate ? GameInput::move_down
+                                                  : GameInput::hard_drop;
+    } else if (piece.orientation != m_target.orientation) {
+        input = GameInput::rotate;
+    } else if (piece.column > m_target.column) {
+        input = GameInput::move_left;
+    } else if (piece.column < m_target.column) {
+        input = GameInput::move_right;
+    }
+    m_last_piece = piece;
+    m_last_input = input;
+    return input;
+}
+
+void GreedyInputPolicy::PlanTarget(const GameCore &game_core) {
+    const GridLogic &grid_logic{game_core.GetGridLogic()};
+    const Piece &piece{game_core.GetActivePiece()};
+    int number_rows{grid_logic.GetNumberOfRows()};
+    int number_columns{grid_logic.GetNumberOfColumns()};
+
+    // the piece falls onto the topmost locked cell of every column, the
+    // cells of the piece itself are not locked
+    m_surface_rows.assign(number_columns, number_rows);
+    for (int column{0}; column < number_columns; ++column) {
+        for (int row{0}; row < number_rows; ++row) {
+            if (grid_logic.GetCellType(row, column) !=
+                TetrominoType::UNDEFINED) {
+                m_surface_rows[column] = row;
+                break;
+            }
+        }
+    }
+
+    m_has_target = true;
+    m_target = piece;
+    int min_number_holes{number_rows * number_columns};
+    int min_height{number_rows};
+    for (int orientation_index{0}; orientation_index < kNumberOrientations;
+         ++orientation_index) {
+        Orientation orientation{static_cast<Orientation>(orientation_index)};
+        const TetrominoShapeInfo &info{GetShapeInfo(piece.type, orientation)};
+        for (int column{-info.left_column};
+             column + info.right_column < number_columns; ++column) {
+            // the box row at which the piece lands is limited by the column
+            // it reaches first
+            int row{number_rows};
+            for (int box_column{info.left_column};
+                 box_column <= info.right_column; ++box_column) {
+                int lowest_row{info.lowest_rows[box_column]};
+                row = std::min(row, m_surface_rows[column + box_column] - 1 -
+                                        lowest_row);
+            }
+            if (row + info.top_row < 0) {
+                continue;
+            }
+            int number_holes{0};
+            for (int box_column{info.left_column};
+                 box_column <= info.right_column; ++box_column) {
+                number_holes += m_surface_rows[column + box_column] - 1 -
+                                (row + info.lowest_rows[box_column]);
+            }
+            int height{number_rows - (row + info.top_row)};
+            if (number_holes < min_number_holes ||
+                (number_holes == min_number_holes && height < min_height)) {
+                min_number_holes = number_holes;
+                min_height = height;
+                m_target = MakePiece(piece.type, orientation, row, column);
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef INPUT_POLICY_H_
+#define INPUT_POLICY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "GameCore.h"
+#include "Piece.h"
+
+/// Interface of a player feeding a GameCore with inputs, e.g. a bot being
+/// evaluated by the batch simulator. A policy is used by a single thread and
+/// plays one game at a time.
+class IInputPolicy {
+   public:
+    virtual ~IInputPolicy() = default;
+
+    /// Prepares the policy for a new game.
+    /// \param seed: seed of the game, policies making random decisions derive
+    ///              them from it only, so that games can be reproduced
+    virtual void Reset(std::uint64_t seed) = 0;
+
+    /// Decides about the next input.
+    /// \param game_core: game being played
+    /// \return input which is passed to GameCore::Step() next
+    virtual GameInput GetNextInput(const GameCore &game_core) = 0;
+};
+
+/// Player pressing random keys, with moves down and hard drops being rarer
+/// than moves to the side and rotations.
+class RandomInputPolicy : public IInputPolicy {
+   public:
+    void Reset(std::uint64_t seed) override { m_state = seed; }
+
+    GameInput GetNextInput(const GameCore &game_core) override;
+
+   private:
+    std::uint64_t m_state{0};
+};
+
+/// Player placing every piece greedily. When a piece spawns, the policy
+/// evaluates every orientation and column the piece could be hard dropped
+/// from and picks the one leaving the fewest holes below the piece and,
+/// among those, the lowest landing position. It then rotates and moves the
+/// piece there and hard drops it.
+class GreedyInputPolicy : public IInputPolicy {
+   public:
+    void Reset(std::uint64_t seed) override;
+
+    GameInput GetNextInput(const GameCore &game_core) override;
+
+   private:
+    bool m_has_target{false};
+    Piece m_target{};
+    // GameCore::GetNumberOfSpawnedPieces() when the target has been planned
+    long m_number_spawned_pieces{0};
+    // the piece and the input of the previous call, to detect blocked moves
+    Piece m_last_piece{};
+    GameInput m_last_input{GameInput::none};
+    // row of the topmost locked cell of every column, the number of rows for
+    // empty columns
+    std::vector<int> m_surface_rows;
+
+    /// Determines the placement of a spawned piece.
+    void PlanTarget(const GameCore &game_core);
+};
+
+#endif /* INPUT_POLICY_H_ */
@@ -0,0 +1,104 @@
+#ifndef PIECE_H_
+#define PIECE_H_
+
+#include <type_traits>
+
+#include "IGridLogic.h"
+#include "TetrominoGeometry.h"
+
+/// Compact value representation of a tetromino for the engine core. As
+/// opposed to the Tetromino class hierarchy, a piece neither has virtual
+/// methods nor refers to a grid, so it is trivially copyable and can be
+/// stored, compared and cloned freely, e.g. by a search trying many moves.
+/// The position is given by the top left corner of the 4x4 box the piece
+/// rotates in, see kTetrominoSquareOffsets. Movement and rotation only change
+/// the box position or the orientation and look up everything else in the
+/// tables of TetrominoGeometry.h. Use MakePiece() to create a piece.
+struct Piece {
+    TetrominoType type;
+    Orientation orientation;
+    /// row of the box's top left corner
+    int row;
+    /// column of the box's top left corner
+    int column;
+    /// occupancy of the box, see TetrominoShapeInfo::box_mask
+    BoxMaskType cell_mask;
+
+    /// Retrieves the square offsets relative to the box
+    constexpr const SquareOffsetsType &GetSquareOffsets() const {
+        return ::GetSquareOffsets(type, orientation);
+    }
+
+    /// Retrieves the precomputed shape properties, see kTetrominoShapeInfos
+    constexpr const TetrominoShapeInfo &GetShapeInfo() const {
+        return ::GetShapeInfo(type, orientation);
+    }
+
+    /// Determines whether a cell of the box belongs to the piece.
+    /// \param row_offset:    row within the box, 0 to 3
+    /// \param column_offset: column within the box, 0 to 3
+    constexpr bool IsBoxCellOccupied(int row_offset, int column_offset) const {
+        return ((cell_mask >> (4 * row_offset + column_offset)) & 1U) != 0;
+    }
+
+    /// Retrieves the piece moved by the specified number of rows and columns
+    /// \param delta_row:    number of rows to move, positive is downwards
+    /// \param delta_column: number of columns to move, positive is rightwards
+    constexpr Piece Translated(int delta_row, int delta_column) const {
+        return {type, orientation, row + delta_row, column + delta_column,
+                cell_mask};
+    }
+
+    /// Retrieves the piece rotated clockwise within its box
+    constexpr Piece RotatedClockwise() const {
+        Orientation next_orientation{GetNextClockwiseOrientation(orientation)};
+        return {type, next_orientation, row, column,
+                GetBoxMask(type, next_orientation)};
+    }
+
+    /// Retrieves the grid cells covered by the piece. The order of the cells
+    /// matches the order of the squares of the Shape[X] classes.
+    TetrominoPositionType GetCells() const {
+        TetrominoPositionType cells;
+        for (const auto &offset : GetSquareOffsets()) {
+            cells.push_back({row + offset.first, column + offset.second});
+        }
+        return cells;
+    }
+
+    constexpr bool operator==(const Piece &other) const {
+        return type == other.type && orientation == other.orientation &&
+               row == other.row && column == other.column &&
+               cell_mask == other.cell_mask;
+    }
+    constexpr bool operator!=(const Piece &other) const {
+        return !(*this == other);
+    }
+};
+
+static_assert(std::is_trivially_copyable<Piece>::value,
+              "pieces must be copyable with memcpy");
+static_assert(!std::is_polymorphic<Piece>::value, "pieces have no vtable");
+
+/// Creates a piece at the specified position.
+/// \param type:        type of the piece, must not be UNDEFINED
+/// \param orientation: orientation of the piece
+/// \param row:         row of the box's top left corner
+/// \param column:      column of the box's top left corner
+constexpr Piece MakePiece(TetrominoType type, Orientation orientation, int row,
+                          int column) {
+    return {type, orientation, row, column, GetBoxMask(type, orientation)};
+}
+
+/// Creates a piece in the orientation north such that its topmost squares
+/// are in the first row and the piece is centered horizontally, rounded to
+/// the left on grids with an odd number of columns.
+/// \param type:           type of the piece, must not be UNDEFINED
+/// \param number_columns: number of columns of the grid
+constexpr Piece MakeSpawnPiece(TetrominoType type, int number_columns) {
+    const TetrominoShapeInfo &info{GetShapeInfo(type, Orientation::north)};
+    return MakePiece(type, Orientation::north, info.spawn_row,
+                     number_columns / 2 + info.spawn_column_offset);
+}
+
+#endif /* PIECE_H_ */
@@ -0,0 +1,108 @@
+#ifndef PIECE_QUEUE_H_
+#define PIECE_QUEUE_H_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "PieceRandomizer.h"
+#include "TetrominoGeometry.h"
+
+/// The PieceQueue class holds the types of the tetrominoes waiting behind the
+/// active piece, the first one being spawned next. Only the types are kept,
+/// the piece itself is made when it spawns. The types are stored in a fixed
+/// ring of 16 elements, so the queue never allocates, a spawn moves no
+/// element, and any length from 1 to 14 costs the same, e.g. for a bot
+/// looking far ahead.
+class PieceQueue {
+   public:
+    /// minimum and maximum number of tetrominoes in the queue
+    static constexpr int kMinLength{1};
+    static constexpr int kMaxLength{14};
+
+    /// number of tetrominoes shown by default
+    static constexpr int kDefaultLength{3};
+
+    /// Creates a queue of tetrominoes of type I, see Fill().
+    /// \param length: number of tetrominoes in the queue, from kMinLength to
+    ///                kMaxLength
+    explicit PieceQueue(int length = kDefaultLength)
+        : m_length{static_cast<std::uint8_t>(length)} {
+        assert(length >= kMinLength && length <= kMaxLength);
+    }
+
+    /// Retrieves the number of tetrominoes in the queue.
+    int size() const { return m_length; }
+
+    /// Retrieves a tetromino of the queue.
+    /// \param index: position in the queue, 0 is the one spawned next
+    TetrominoType operator[](int index) const {
+        return m_types[(m_front + index) & kIndexMask];
+    }
+
+    /// Retrieves the tetromino spawned next.
+    TetrominoType front() const { return (*this)[0]; }
+
+    /// Retrieves the tetromino appended last.
+    TetrominoType back() const { return (*this)[m_length - 1]; }
+
+    /// Replaces all tetrominoes of the queue by new ones in one go.
+    /// \param piece_randomizer: generator of the new tetrominoes
+    void Fill(PieceRandomizer &piece_randomizer) {
+        m_front = 0;
+        piece_randomizer.Generate(m_types.data(), m_length);
+    }
+
+    /// Takes the tetromino spawned next and appends another one.
+    /// \param type: tetromino being appended
+    /// \return the tetromino taken from the front
+    TetrominoType PopAndPush(TetrominoType type) {
+        TetrominoType front_type{front()};
+        m_types[(m_front + m_length) & kIndexMask] = type;
+        m_front = static_cast<std::uint8_t>((m_front + 1) & kIndexMask);
+        return front_type;
+    }
+
+    /// Replaces the queue by tetrominoes in the order of spawning, e.g. to
+    /// restore a saved queue.
+    /// \param types:  tetrominoes of the queue
+    /// \param length: number of tetrominoes, from kMinLength to kMaxLength
+    void Assign(const TetrominoType *types, int length) {
+        assert(length >= kMinLength && length <= kMaxLength);
+        m_front = 0;
+        m_length = static_cast<std::uint8_t>(length);
+        for (int index{0}; index < length; ++index) {
+            m_types[index] = types[index];
+        }
+    }
+
+    /// Determines whether two queues hold the same tetrominoes in the same
+    /// order, no matter where they are in the ring.
+    bool operator==(const PieceQueue &other) const {
+        if (m_length != other.m_length) {
+            return false;
+        }
+        for (int index{0}; index < m_length; ++index) {
+            if ((*this)[index] != other[index]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const PieceQueue &other) const {
+        return !(*this == other);
+    }
+
+   private:
+    // the ring is a power of two to map positions by a mask
+    static constexpr int kCapacity{16};
+    static constexpr int kIndexMask{kCapacity - 1};
+    static_assert(kMaxLength < kCapacity, "the ring holds the queue");
+
+    std::array<TetrominoType, kCapacity> m_types{};
+    std::uint8_t m_front{0};
+    std::uint8_t m_length;
+};
+
+#endif /* PIECE_QUEUE_H_ */
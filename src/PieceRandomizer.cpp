@@ -0,0 +1,131 @@
+#include "PieceRandomizer.h"
+
+#include <algorithm>
+#include <random>
+
+PieceRandomizer::PieceRandomizer() : PieceRandomizer(GenerateSeed()) {}
+
+PieceRandomizer::PieceRandomizer(std::uint64_t seed, RandomizerPolicy policy)
+    : m_seed{seed}, m_state{seed}, m_policy{policy} {
+    // start as if S and Z have been picked last, so that a game rarely
+    // begins with one of them
+    m_history = {static_cast<std::uint8_t>(TetrominoType::Z),
+                 static_cast<std::uint8_t>(TetrominoType::S),
+                 static_cast<std::uint8_t>(TetrominoType::Z),
+                 static_cast<std::uint8_t>(TetrominoType::S)};
+}
+
+TetrominoType PieceRandomizer::Next() {
+    switch (m_policy) {
+        case RandomizerPolicy::bag:
+            return NextOfBag();
+        case RandomizerPolicy::history:
+            return NextWithHistory();
+        default:
+            return NextUniform();
+    }
+}
+
+void PieceRandomizer::Generate(TetrominoType *types,
+                               std::size_t number_types) {
+    // dispatch on the policy once for the entire buffer
+    switch (m_policy) {
+        case RandomizerPolicy::bag:
+            std::generate_n(types, number_types,
+                            [this] { return NextOfBag(); });
+            break;
+        case RandomizerPolicy::history:
+            std::generate_n(types, number_types,
+                            [this] { return NextWithHistory(); });
+            break;
+        default:
+            std::generate_n(types, number_types,
+                            [this] { return NextUniform(); });
+            break;
+    }
+}
+
+void PieceRandomizer::WriteState(ByteWriter &writer) const {
+    writer.PutFixed(m_seed, 8);
+    writer.PutFixed(m_state, 8);
+    writer.PutFixed(static_cast<std::uint64_t>(m_policy), 1);
+    writer.PutFixed(m_number_types_left_in_bag, 1);
+    for (std::uint8_t type : m_bag) {
+        writer.PutFixed(type, 1);
+    }
+    for (std::uint8_t type : m_history) {
+        writer.PutFixed(type, 1);
+    }
+}
+
+bool PieceRandomizer::ReadState(ByteReader &reader) {
+    PieceRandomizer randomizer{reader.GetFixed(8)};
+    randomizer.m_state = reader.GetFixed(8);
+    std::uint64_t policy{reader.GetFixed(1)};
+    std::uint64_t number_types_left_in_bag{reader.GetFixed(1)};
+    bool is_valid{policy <= static_cast<int>(RandomizerPolicy::history) &&
+                  number_types_left_in_bag <= kNumberTetrominoTypes};
+    for (std::uint8_t &type : randomizer.m_bag) {
+        type = static_cast<std::uint8_t>(reader.GetFixed(1));
+        is_valid = is_valid && type < kNumberTetrominoTypes;
+    }
+    for (std::uint8_t &type : randomizer.m_history) {
+        type = static_cast<std::uint8_t>(reader.GetFixed(1));
+        is_valid = is_valid && type < kNumberTetrominoTypes;
+    }
+    if (!reader.IsValid() || !is_valid) {
+        return false;
+    }
+    randomizer.m_policy = static_cast<RandomizerPolicy>(policy);
+    randomizer.m_number_types_left_in_bag =
+        static_cast<std::uint8_t>(number_types_left_in_bag);
+    *this = randomizer;
+    return true;
+}
+
+std::uint64_t PieceRandomizer::GenerateSeed() {
+    std::random_device random_device;
+    return (static_cast<std::uint64_t>(random_device()) << 32) ^
+           random_device();
+}
+
+int PieceRandomizer::NextIndex(int number_indexes) {
+    // scale the upper 32 bits to the range instead of using a modulo, the
+    // bias is negligible for the few indexes needed here
+    return static_cast<int>(((NextSplitMix64(m_state) >> 32) *
+                             static_cast<std::uint64_t>(number_indexes)) >>
+                            32);
+}
+
+TetrominoType PieceRandomizer::NextUniform() {
+    return static_cast<TetrominoType>(NextIndex(kNumberTetrominoTypes));
+}
+
+TetrominoType PieceRandomizer::NextOfBag() {
+    if (m_number_types_left_in_bag == 0) {
+        for (int type{0}; type < kNumberTetrominoTypes; ++type) {
+            m_bag[type] = static_cast<std::uint8_t>(type);
+        }
+        m_number_types_left_in_bag = kNumberTetrominoTypes;
+    }
+    // pick one of the types left and move the last type left into its place
+    int index{NextIndex(m_number_types_left_in_bag)};
+    std::uint8_t type{m_bag[index]};
+    --m_number_types_left_in_bag;
+    m_bag[index] = m_bag[m_number_types_left_in_bag];
+    return static_cast<TetrominoType>(type);
+}
+
+TetrominoType PieceRandomizer::NextWithHistory() {
+    std::uint8_t type{0};
+    for (int roll{0}; roll <= kNumberHistoryRerolls; ++roll) {
+        type = static_cast<std::uint8_t>(NextIndex(kNumberTetrominoTypes));
+        if (std::find(m_history.begin(), m_history.end(), type) ==
+            m_history.end()) {
+            break;
+        }
+    }
+    std::rotate(m_history.rbegin(), m_history.rbegin() + 1, m_history.rend());
+    m_history.front() = type;
+    return static_cast<TetrominoType>(type);
+}
@@ -0,0 +1,108 @@
+#ifndef PIECE_RANDOMIZER_H_
+#define PIECE_RANDOMIZER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ByteStream.h"
+#include "TetrominoGeometry.h"
+
+/// Advances a SplitMix64 state and retrieves its next output, see
+/// https://prng.di.unimi.it/splitmix64.c
+/// \param state: state of the generator, any value is a valid seed
+inline std::uint64_t NextSplitMix64(std::uint64_t &state) {
+    std::uint64_t number{state += 0x9E3779B97F4A7C15ULL};
+    number = (number ^ (number >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    number = (number ^ (number >> 27)) * 0x94D049BB133111EBULL;
+    return number ^ (number >> 31);
+}
+
+/// How a PieceRandomizer picks the next tetromino type
+enum class RandomizerPolicy : std::uint8_t {
+    uniform,  // every type with the same probability, independent of the
+              // types picked before
+    bag,      // all seven types in random order, then the next permutation
+    history   // types among the last picked ones are rerolled a few times
+};
+
+/// The PieceRandomizer class generates the sequence of tetromino types a game
+/// spawns. The sequence is determined by the seed and the policy alone, so a
+/// game can be reproduced by passing the same seed again. The state fits into
+/// a few bytes and is trivially copyable, so a search can copy a randomizer
+/// to look ahead without disturbing the original. Random numbers are drawn by
+/// SplitMix64, which needs no allocation and no system call.
+class PieceRandomizer {
+   public:
+    /// number of picked types the history policy remembers
+    static constexpr int kHistoryLength{4};
+
+    /// number of rerolls of the history policy before a type among the last
+    /// picked ones is accepted
+    static constexpr int kNumberHistoryRerolls{4};
+
+    /// Creates a uniform randomizer with a seed taken from the random device.
+    PieceRandomizer();
+
+    /// Creates a randomizer generating the same sequence for the same seed.
+    /// \param seed:   seed of the sequence
+    /// \param policy: how the types are picked
+    explicit PieceRandomizer(std::uint64_t seed, RandomizerPolicy policy =
+                                                     RandomizerPolicy::uniform);
+
+    /// Picks the next tetromino type.
+    TetrominoType Next();
+
+    /// Picks the next tetromino types in one go, which is the same as calling
+    /// Next() for each of them.
+    /// \param types:        buffer receiving the types
+    /// \param number_types: number of types to pick, the buffer is expected to
+    ///                      hold at least as many elements
+    void Generate(TetrominoType *types, std::size_t number_types);
+
+    /// Retrieves the seed the randomizer has been created with.
+    std::uint64_t GetSeed() const { return m_seed; }
+
+    /// Retrieves how the types are picked.
+    RandomizerPolicy GetPolicy() const { return m_policy; }
+
+    /// Appends the entire state of the randomizer, i.e. the seed, the policy,
+    /// the generator state, the bag and the history, in 26 bytes.
+    /// \param writer: writer receiving the state
+    void WriteState(ByteWriter &writer) const;
+
+    /// Replaces the state of the randomizer by one written by WriteState(),
+    /// so the randomizer continues the sequence where the written one was.
+    /// \param reader: reader holding the state
+    /// \return false if the data ran out or is not a valid state, in which
+    ///         case the randomizer is unchanged
+    bool ReadState(ByteReader &reader);
+
+    /// Retrieves a seed from the random device, e.g. for a game which does not
+    /// need to be reproduced.
+    static std::uint64_t GenerateSeed();
+
+   private:
+    std::uint64_t m_seed;
+    std::uint64_t m_state;
+    RandomizerPolicy m_policy;
+    // types of the current bag which have not been picked yet are kept at the
+    // front of m_bag
+    std::uint8_t m_number_types_left_in_bag{0};
+    std::array<std::uint8_t, kNumberTetrominoTypes> m_bag{};
+    // last picked types of the history policy, the latest one first
+    std::array<std::uint8_t, kHistoryLength> m_history{};
+
+    /// Retrieves a random index in [0, number_indexes).
+    int NextIndex(int number_indexes);
+
+    TetrominoType NextUniform();
+    TetrominoType NextOfBag();
+    TetrominoType NextWithHistory();
+};
+
+static_assert(std::is_trivially_copyable<PieceRandomizer>::value,
+              "randomizers must be copyable with memcpy");
+
+#endif /* PIECE_RANDOMIZER_H_ */
@@ -0,0 +1,208 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "ByteStream.h"
+
+namespace {
+
+constexpr char kMagic[4]{'T', 'R', 'P', 'L'};
+constexpr std::uint8_t kVersion{1};
+constexpr std::size_t kHeaderSize{4 + 4 + 2 * 2 + 3 * 8};
+// bounds the grid a decoded replay is played on, far beyond any playable one
+constexpr std::int64_t kMaxNumberGridCells{1 << 16};
+
+}  // namespace
+
+ReplayRecorder::ReplayRecorder(const GameCore &game_core) {
+    const PieceRandomizer &piece_randomizer{game_core.GetPieceRandomizer()};
+    m_replay.header.seed = piece_randomizer.GetSeed();
+    m_replay.header.randomizer_policy = piece_randomizer.GetPolicy();
+    m_replay.header.gravity_mode = game_core.GetGravityMode();
+    m_replay.header.number_grid_rows =
+        game_core.GetGridLogic().GetNumberOfRows();
+    m_replay.header.number_grid_columns =
+        game_core.GetGridLogic().GetNumberOfColumns();
+    game_core.SaveState(m_replay.initial_state);
+    m_replay.number_ticks = game_core.GetNumberOfTicks();
+    m_replay.final_state_hash = game_core.ComputeStateHash();
+}
+
+void ReplayRecorder::Record(GameInput input, const GameCore &game_core) {
+    m_replay.number_ticks = game_core.GetNumberOfTicks();
+    m_replay.final_state_hash = game_core.ComputeStateHash();
+    if (input != GameInput::none) {
+        m_replay.events.push_back(
+            {m_replay.number_ticks - 1, input,
+             static_cast<std::uint32_t>(m_replay.final_state_hash)});
+    }
+}
+
+ReplayResult PlayReplay(const Replay &replay) {
+    const ReplayHeader &header{replay.header};
+    GameCore game_core{
+        header.number_grid_rows, header.number_grid_columns,
+        header.gravity_mode,
+        PieceRandomizer{header.seed, header.randomizer_policy}};
+
+    ReplayResult result;
+    if (!replay.initial_state.empty() &&
+        !game_core.RestoreState(replay.initial_state.data(),
+                                replay.initial_state.size())) {
+        return result;
+    }
+    std::size_t event_index{0};
+    for (std::uint64_t tick{game_core.GetNumberOfTicks()};
+         tick < replay.number_ticks; ++tick) {
+        bool is_event_tick{event_index < replay.events.size() &&
+                           replay.events[event_index].tick == tick};
+        if (!is_event_tick) {
+            game_core.Step(GameInput::none);
+            continue;
+        }
+        const ReplayEvent &event{replay.events[event_index++]};
+        game_core.Step(event.input);
+        if (static_cast<std::uint32_t>(game_core.ComputeStateHash()) !=
+            event.state_hash) {
+            result.mismatch_detection_tick = tick;
+            result.number_ticks = tick + 1;
+            result.final_state_hash = game_core.ComputeStateHash();
+            result.score = game_core.GetScore();
+            return result;
+        }
+    }
+    result.number_ticks = replay.number_ticks;
+    result.final_state_hash = game_core.ComputeStateHash();
+    result.score = game_core.GetScore();
+    result.is_identical = result.final_state_hash == replay.final_state_hash;
+    result.mismatch_detection_tick =
+        result.is_identical || replay.number_ticks == 0
+            ? replay.number_ticks
+            : replay.number_ticks - 1;
+    return result;
+}
+
+std::vector<std::uint8_t> SerializeReplay(const Replay &replay) {
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(kHeaderSize + replay.initial_state.size() + 20 +
+                   6 * replay.events.size());
+    ByteWriter writer{buffer};
+    for (char magic_character : kMagic) {
+        writer.PutFixed(static_cast<std::uint8_t>(magic_character), 1);
+    }
+    writer.PutFixed(kVersion, 1);
+    writer.PutFixed(static_cast<std::uint64_t>(replay.header.randomizer_policy),
+                    1);
+    writer.PutFixed(static_cast<std::uint64_t>(replay.header.gravity_mode), 1);
+    writer.PutFixed(0, 1);
+    writer.PutFixed(static_cast<std::uint64_t>(replay.header.number_grid_rows),
+                    2);
+    writer.PutFixed(
+        static_cast<std::uint64_t>(replay.header.number_grid_columns), 2);
+    writer.PutFixed(replay.header.seed, 8);
+    writer.PutFixed(replay.number_ticks, 8);
+    writer.PutFixed(replay.final_state_hash, 8);
+
+    writer.PutVarint(replay.initial_state.size());
+    std::copy(replay.initial_state.begin(), replay.initial_state.end(),
+              writer.PutBytes(replay.initial_state.size()));
+
+    writer.PutVarint(replay.events.size());
+    std::uint64_t previous_tick{0};
+    for (const ReplayEvent &event : replay.events) {
+        writer.PutVarint(event.tick - previous_tick);
+        writer.PutFixed(static_cast<std::uint64_t>(event.input), 1);
+        writer.PutFixed(event.state_hash, 4);
+        previous_tick = event.tick;
+    }
+    return buffer;
+}
+
+bool DeserializeReplay(const std::uint8_t *data, std::size_t size,
+                       Replay &replay) {
+    ByteReader reader{data, size};
+    for (char magic_character : kMagic) {
+        if (reader.GetFixed(1) != static_cast<std::uint8_t>(magic_character)) {
+            return false;
+        }
+    }
+    std::uint64_t version{reader.GetFixed(1)};
+    if (version != kVersion) {
+        return false;
+    }
+    std::uint64_t randomizer_policy{reader.GetFixed(1)};
+    std::uint64_t gravity_mode{reader.GetFixed(1)};
+    reader.GetFixed(1);
+    if (randomizer_policy > static_cast<int>(RandomizerPolicy::history) ||
+        gravity_mode > static_cast<int>(GravityMode::cascade)) {
+        return false;
+    }
+    replay.header.randomizer_policy =
+        static_cast<RandomizerPolicy>(randomizer_policy);
+    replay.header.gravity_mode = static_cast<GravityMode>(gravity_mode);
+    replay.header.number_grid_rows = static_cast<int>(reader.GetFixed(2));
+    replay.header.number_grid_columns = static_cast<int>(reader.GetFixed(2));
+    replay.header.seed = reader.GetFixed(8);
+    replay.number_ticks = reader.GetFixed(8);
+    replay.final_state_hash = reader.GetFixed(8);
+    if (replay.header.number_grid_rows < 4 ||
+        replay.header.number_grid_columns < 4 ||
+        static_cast<std::int64_t>(replay.header.number_grid_rows) *
+                replay.header.number_grid_columns >
+            kMaxNumberGridCells) {
+        return false;
+    }
+
+    std::uint64_t state_size{reader.GetVarint()};
+    if (!reader.IsValid() || state_size > reader.GetRemainingSize()) {
+        return false;
+    }
+    const std::uint8_t *state{
+        reader.GetBytes(static_cast<std::size_t>(state_size))};
+    replay.initial_state.assign(state, state + state_size);
+
+    // every event takes at least 6 bytes, which bounds the number of events
+    // before anything is allocated
+    std::uint64_t number_events{reader.GetVarint()};
+    if (!reader.IsValid() || number_events > reader.GetRemainingSize() / 6) {
+        return false;
+    }
+    replay.events.clear();
+    replay.events.reserve(static_cast<std::size_t>(number_events));
+    std::uint64_t tick{0};
+    for (std::uint64_t index{0}; index < number_events; ++index) {
+        tick += reader.GetVarint();
+        std::uint64_t input{reader.GetFixed(1)};
+        std::uint32_t state_hash{
+            static_cast<std::uint32_t>(reader.GetFixed(4))};
+        bool is_tick_ascending{index == 0 || tick > replay.events.back().tick};
+        if (!reader.IsValid() || !is_tick_ascending ||
+            tick >= replay.number_ticks || input == 0 ||
+            input > static_cast<int>(GameInput::new_game)) {
+            return false;
+        }
+        replay.events.push_back(
+            {tick, static_cast<GameInput>(input), state_hash});
+    }
+    return reader.IsAtEnd();
+}
+
+bool SaveReplay(const Replay &replay, const std::string &path) {
+    std::vector<std::uint8_t> buffer{SerializeReplay(replay)};
+    std::ofstream file{path, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+
+bool LoadReplay(const std::string &path, Replay &replay) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    std::vector<std::uint8_t> buffer{std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>()};
+    return DeserializeReplay(buffer.data(), buffer.size(), replay);
+}
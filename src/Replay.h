@@ -0,0 +1,120 @@
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameCore.h"
+#include "PieceRandomizer.h"
+
+/// Settings of the GameCore a replay has been recorded with
+struct ReplayHeader {
+    std::uint64_t seed{0};
+    RandomizerPolicy randomizer_policy{RandomizerPolicy::uniform};
+    GravityMode gravity_mode{GravityMode::line};
+    int number_grid_rows{20};
+    int number_grid_columns{10};
+};
+
+/// Input passed to GameCore::Step() at a tick
+struct ReplayEvent {
+    /// tick of the step, see GameCore::GetNumberOfTicks()
+    std::uint64_t tick{0};
+    GameInput input{GameInput::none};
+    /// lower 32 bits of GameCore::ComputeStateHash() after the step
+    std::uint32_t state_hash{0};
+};
+
+/// Recorded game, consisting of the settings and the initial state of the
+/// game core and all inputs except GameInput::none in the order of their
+/// ticks. Steps without input are not recorded but counted by number_ticks.
+struct Replay {
+    ReplayHeader header;
+    /// GameCore::SaveState() at the start of the recording, the state of a
+    /// new GameCore created from the header if empty
+    std::vector<std::uint8_t> initial_state;
+    std::vector<ReplayEvent> events;
+    /// number of steps of the recorded game
+    std::uint64_t number_ticks{0};
+    /// GameCore::ComputeStateHash() after the last step
+    std::uint64_t final_state_hash{0};
+};
+
+/// Outcome of playing a replay back
+struct ReplayResult {
+    /// true if the state after every recorded event and the final state
+    /// match the recorded hashes
+    bool is_identical{false};
+    /// tick after which a deviation from the recording has been detected,
+    /// the number of ticks if none has been. As state hashes are recorded
+    /// only for ticks with an input and for the last tick, the state may
+    /// have deviated after any tick since the previous recorded input.
+    std::uint64_t mismatch_detection_tick{0};
+    /// number of steps played
+    std::uint64_t number_ticks{0};
+    /// GameCore::ComputeStateHash() after the last step played
+    std::uint64_t final_state_hash{0};
+    int score{0};
+};
+
+/// The ReplayRecorder class records the inputs a GameCore is fed with.
+class ReplayRecorder {
+   public:
+    /// Starts a recording of a game core in its current state, which is
+    /// saved as the initial state of the replay. So the game core may as
+    /// well have been stepped or restored before.
+    /// \param game_core: game core being recorded
+    explicit ReplayRecorder(const GameCore &game_core);
+
+    /// Records an input after it has been passed to GameCore::Step().
+    /// \param input:     input of the step
+    /// \param game_core: game core after the step
+    void Record(GameInput input, const GameCore &game_core);
+
+    /// Retrieves the replay recorded so far.
+    const Replay &GetReplay() const { return m_replay; }
+
+   private:
+    Replay m_replay;
+};
+
+/// Plays a replay back on a new GameCore restored to the initial state as
+/// fast as possible and checks the state hash after every recorded event.
+/// Playing stops at the first deviation, a replay whose initial state cannot
+/// be restored is not played at all.
+/// \param replay: replay being played
+ReplayResult PlayReplay(const Replay &replay);
+
+/// Encodes a replay in the compact binary replay format. The format starts
+/// with the magic "TRPL", a version byte, the randomizer policy, the gravity
+/// mode, a reserved byte, the number of rows and columns as 16 bit values
+/// and the seed, the number of ticks and the final state hash as 64 bit
+/// values. The initial state follows as its size as a varint and its bytes,
+/// then the number of events as a varint. Every event takes the tick
+/// distance to the previous event as a varint, the input as one byte and the
+/// state hash as a 32 bit value. All fixed size values are little endian, so
+/// most events take 6 bytes.
+/// \param replay: replay being encoded
+std::vector<std::uint8_t> SerializeReplay(const Replay &replay);
+
+/// Decodes a replay encoded by SerializeReplay(). Replays of grids with
+/// fewer than 4 rows or columns or more than 65536 cells are rejected.
+/// \param data:   encoded replay
+/// \param size:   number of bytes of the encoded replay
+/// \param replay: receives the replay
+/// \return false if the data is not a valid replay, the replay is undefined
+///         then
+bool DeserializeReplay(const std::uint8_t *data, std::size_t size,
+                       Replay &replay);
+
+/// Writes a replay to a file in the binary replay format.
+/// \return false if the file could not be written
+bool SaveReplay(const Replay &replay, const std::string &path);
+
+/// Reads a replay from a file in the binary replay format.
+/// \return false if the file could not be read or is not a valid replay
+bool LoadReplay(const std::string &path, Replay &replay);
+
+#endif /* REPLAY_H_ */
@@ -0,0 +1,171 @@
+#include "RowScan.h"
+
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROW_SCAN_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+bool IsRowFullScalar(const RowBitsType *words, int number_words,
+                     RowBitsType last_word_mask) {
+    RowBitsType all_bits{~RowBitsType{0}};
+    for (int index{0}; index < number_words - 1; ++index) {
+        all_bits &= words[index];
+    }
+    return all_bits == ~RowBitsType{0} &&
+           words[number_words - 1] == last_word_mask;
+}
+
+bool IsRowEmptyScalar(const RowBitsType *words, int number_words) {
+    RowBitsType any_bits{0};
+    for (int index{0}; index < number_words; ++index) {
+        any_bits |= words[index];
+    }
+    return any_bits == 0;
+}
+
+#ifdef ROW_SCAN_X86_SIMD
+__attribute__((target("sse4.1"))) bool IsRowFullSse41(
+    const RowBitsType *words, int number_words, RowBitsType last_word_mask) {
+    const __m128i all_ones{_mm_set1_epi64x(-1)};
+    int index{0};
+    for (; index + 2 <= number_words - 1; index += 2) {
+        __m128i chunk{_mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(words + index))};
+        if (!_mm_testc_si128(chunk, all_ones)) {
+            return false;
+        }
+    }
+    for (; index < number_words - 1; ++index) {
+        if (words[index] != ~RowBitsType{0}) {
+            return false;
+        }
+    }
+    return words[number_words - 1] == last_word_mask;
+}
+
+__attribute__((target("sse4.1"))) bool IsRowEmptySse41(
+    const RowBitsType *words, int number_words) {
+    int index{0};
+    for (; index + 2 <= number_words; index += 2) {
+        __m128i chunk{_mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(words + index))};
+        if (!_mm_testz_si128(chunk, chunk)) {
+            return false;
+        }
+    }
+    return index == number_words || words[index] == 0;
+}
+
+__attribute__((target("avx2"))) bool IsRowFullAvx2(
+    const RowBitsType *words, int number_words, RowBitsType last_word_mask) {
+    const __m256i all_ones{_mm256_set1_epi64x(-1)};
+    int index{0};
+    for (; index + 4 <= number_words - 1; index += 4) {
+        __m256i chunk{_mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(words + index))};
+        if (!_mm256_testc_si256(chunk, all_ones)) {
+            return false;
+        }
+    }
+    for (; index < number_words - 1; ++index) {
+        if (words[index] != ~RowBitsType{0}) {
+            return false;
+        }
+    }
+    return words[number_words - 1] == last_word_mask;
+}
+
+__attribute__((target("avx2"))) bool IsRowEmptyAvx2(const RowBitsType *words,
+                                                    int number_words) {
+    int index{0};
+    for (; index + 4 <= number_words; index += 4) {
+        __m256i chunk{_mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(words + index))};
+        if (!_mm256_testz_si256(chunk, chunk)) {
+            return false;
+        }
+    }
+    for (; index < number_words; ++index) {
+        if (words[index] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+RowScanImplementation GetFastestSupportedImplementation() {
+    if (IsRowScanImplementationSupported(RowScanImplementation::avx2)) {
+        return RowScanImplementation::avx2;
+    }
+    if (IsRowScanImplementationSupported(RowScanImplementation::sse41)) {
+        return RowScanImplementation::sse41;
+    }
+    return RowScanImplementation::scalar;
+}
+
+std::atomic<RowScanImplementation> &CurrentImplementation() {
+    static std::atomic<RowScanImplementation> implementation{
+        GetFastestSupportedImplementation()};
+    return implementation;
+}
+
+}  // namespace
+
+RowScanImplementation GetRowScanImplementation() {
+    return CurrentImplementation().load(std::memory_order_relaxed);
+}
+
+bool SetRowScanImplementation(RowScanImplementation implementation) {
+    if (!IsRowScanImplementationSupported(implementation)) {
+        return false;
+    }
+    CurrentImplementation().store(implementation, std::memory_order_relaxed);
+    return true;
+}
+
+bool IsRowScanImplementationSupported(RowScanImplementation implementation) {
+    switch (implementation) {
+        case RowScanImplementation::scalar:
+            return true;
+#ifdef ROW_SCAN_X86_SIMD
+        case RowScanImplementation::sse41:
+            return __builtin_cpu_supports("sse4.1");
+        case RowScanImplementation::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+bool IsRowFull(const RowBitsType *words, int number_words,
+               RowBitsType last_word_mask) {
+    switch (GetRowScanImplementation()) {
+#ifdef ROW_SCAN_X86_SIMD
+        case RowScanImplementation::avx2:
+            return IsRowFullAvx2(words, number_words, last_word_mask);
+        case RowScanImplementation::sse41:
+            return IsRowFullSse41(words, number_words, last_word_mask);
+#endif
+        default:
+            return IsRowFullScalar(words, number_words, last_word_mask);
+    }
+}
+
+bool IsRowEmpty(const RowBitsType *words, int number_words) {
+    switch (GetRowScanImplementation()) {
+#ifdef ROW_SCAN_X86_SIMD
+        case RowScanImplementation::avx2:
+            return IsRowEmptyAvx2(words, number_words);
+        case RowScanImplementation::sse41:
+            return IsRowEmptySse41(words, number_words);
+#endif
+        default:
+            return IsRowEmptyScalar(words, number_words);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef ROW_SCAN_H_
+#define ROW_SCAN_H_
+
+#include <cstdint>
+
+/// Bitmask word of a grid row. Bit n of word w corresponds to the cell in
+/// column w * 64 + n.
+using RowBitsType = std::uint64_t;
+
+/// Number of columns (cells) stored in one RowBitsType word
+constexpr int kColumnsPerRowWord{8 * sizeof(RowBitsType)};
+
+/// Available implementations of the row scans. Which one is used is decided
+/// at runtime depending on the instruction sets supported by the CPU.
+enum class RowScanImplementation { scalar, sse41, avx2 };
+
+/// Retrieves the implementation currently used by IsRowFull() and
+/// IsRowEmpty(). Unless changed via SetRowScanImplementation(), this is the
+/// fastest implementation supported by the CPU.
+RowScanImplementation GetRowScanImplementation();
+
+/// Forces a certain implementation of the row scans, e.g. for benchmarks.
+/// \param implementation: implementation to be used from now on
+/// \return false if the CPU does not support the implementation, in which case
+///         the current implementation is kept.
+bool SetRowScanImplementation(RowScanImplementation implementation);
+
+/// Determines whether the CPU supports a certain implementation.
+bool IsRowScanImplementationSupported(RowScanImplementation implementation);
+
+/// Determines whether all cells of a row are occupied.
+/// \param words:          bitmask words of the row
+/// \param number_words:   number of words in the row, at least one
+/// \param last_word_mask: bits of the last word which belong to the row
+bool IsRowFull(const RowBitsType *words, int number_words,
+               RowBitsType last_word_mask);
+
+/// Determines whether all cells of a row are free. Bits of the last word which
+/// do not belong to the row are expected to be zero.
+/// \param words:        bitmask words of the row
+/// \param number_words: number of words in the row, at least one
+bool IsRowEmpty(const RowBitsType *words, int number_words);
+
+#endif /* ROW_SCAN_H_ */
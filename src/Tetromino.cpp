@@ -6,22 +6,20 @@ TetrominoPositionType operator+(const TetrominoPositionType &position1,
                                 const TetrominoPositionType &position2) {
     assert(position1.size() == position2.size());
 
-    TetrominoPositionType result{{0, 0}, {0, 0}, {0, 0}, {0, 0}};
-    for (int idx{0}; idx < result.size(); ++idx) {
-        result.at(idx).first =
-            position1.at(idx).first + position2.at(idx).first;
-        result.at(idx).second =
-            position1.at(idx).second + position2.at(idx).second;
+    TetrominoPositionType result{position1};
+    for (std::size_t idx{0}; idx < result.size(); ++idx) {
+        result[idx].first += position2[idx].first;
+        result[idx].second += position2[idx].second;
     }
     return result;
 }
 
 Tetromino::Tetromino(IGridLogic &grid_logic,
                      TetrominoPositionType init_position, Color color)
-    : m_grid_logic{grid_logic},
-      m_position{init_position},
+    : m_position{init_position},
+      m_grid_logic{grid_logic},
       m_color{color},
-      m_is_locked{false} {};
+      m_is_locked{false} {}
 
 bool Tetromino::MoveOneStep(Direction direction) {
     if (IsLocked()) {
@@ -29,7 +27,7 @@ bool Tetromino::MoveOneStep(Direction direction) {
     }
 
     bool is_movement_succeed{};
-    TetrominoPositionType current_position{GetPosition()};
+    const TetrominoPositionType &current_position{GetPosition()};
     TetrominoPositionType target_position{current_position};
     switch (direction) {
         case Direction::down:
@@ -62,343 +60,100 @@ bool Tetromino::MoveOneStep(Direction direction) {
     return is_movement_succeed;
 }
 
-// iterator: Before erasing, it's iterator pointing to the element beeing
-//           removed
-//           After erasing, it's an iterator following the last removed
-//           element
-void Tetromino::DeleteTetrominoSquare(LogicalSquaresIteratorType &iterator) {
-    iterator = m_position.erase(iterator);
-}
-
-// Create I-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is cyan.
-ShapeI::ShapeI(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::cyan},
-      m_tetromino_type{TetrominoType::I} {}
-
-void ShapeI::Rotate() {
+bool Tetromino::Drop(int number_rows) {
     if (IsLocked()) {
-        return;
-    }
-
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
+        return false;
     }
-}
-
-// Create J-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is blue.
-ShapeJ::ShapeJ(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::blue},
-      m_tetromino_type{TetrominoType::J} {}
 
-void ShapeJ::Rotate() {
-    if (IsLocked()) {
-        return;
+    const TetrominoPositionType &current_position{GetPosition()};
+    TetrominoPositionType target_position{current_position};
+    for (auto &new_square_position : target_position) {
+        new_square_position.first += number_rows;
     }
-
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
+    bool is_movement_succeed{
+        m_grid_logic.RequestSpaceOnGrid(current_position, target_position)};
+    if (is_movement_succeed) {
+        SetPosition(target_position);
     }
+    LockDown();
+    return is_movement_succeed;
 }
 
-// Create L-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is orange.
-ShapeL::ShapeL(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::orange},
-      m_tetromino_type{TetrominoType::L} {}
-
-void ShapeL::Rotate() {
+void Tetromino::RotateClockwise(TetrominoType type, Orientation &orientation) {
     if (IsLocked()) {
         return;
     }
 
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
-    }
-}
-
-// Create O-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is yellow.
-ShapeO::ShapeO(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::yellow},
-      m_tetromino_type{TetrominoType::O} {}
-
-void ShapeO::Rotate() {}
-
-// Create S-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is green.
-ShapeS::ShapeS(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::green},
-      m_tetromino_type{TetrominoType::S} {}
-
-void ShapeS::Rotate() {
-    if (IsLocked()) {
-        return;
+    const SquareOffsetsType &deltas{GetRotationDeltas(type, orientation)};
+    const TetrominoPositionType &current_position{GetPosition()};
+    TetrominoPositionType target_position{current_position};
+    for (std::size_t index{0}; index < target_position.size(); ++index) {
+        target_position[index].first += deltas[index].first;
+        target_position[index].second += deltas[index].second;
     }
-
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
+    if (m_grid_logic.RequestSpaceOnGrid(current_position, target_position)) {
+        SetPosition(target_position);
+        orientation = GetNextClockwiseOrientation(orientation);
     }
 }
 
-// Create T-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is magenta.
-ShapeT::ShapeT(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::magenta},
-      m_tetromino_type{TetrominoType::T} {}
-
-void ShapeT::Rotate() {
-    if (IsLocked()) {
-        return;
+std::optional<Piece> Tetromino::GetPiece() const {
+    TetrominoType type{GetTetrominoType()};
+    if (type == TetrominoType::UNDEFINED ||
+        m_position.size() != kNumberSquaresPerTetromino) {
+        return std::nullopt;
     }
 
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
+    // Shapes created via MakeTetromino() order their squares like the square
+    // offsets, so the box position follows from the first square
+    Orientation orientation{GetOrientation()};
+    const auto &offset{GetSquareOffsets(type, orientation).front()};
+    Piece piece{MakePiece(type, orientation,
+                          m_position.front().first - offset.first,
+                          m_position.front().second - offset.second)};
+    if (piece.GetCells() != m_position) {
+        return std::nullopt;
     }
+    return piece;
 }
 
-// Create Z-shape such that it has its initial position in the upper left
-// corner, its orientation is horizontal and its color is magenta.
-ShapeZ::ShapeZ(IGridLogic &grid_logic, TetrominoPositionType init_position)
-    : m_orientation{Orientation::north},
-      Tetromino{grid_logic, init_position, Color::red},
-      m_tetromino_type{TetrominoType::Z} {}
+// iterator: Before erasing, it's iterator pointing to the element beeing
+//           removed
+//           After erasing, it's an iterator following the last removed
+//           element
+void Tetromino::DeleteTetrominoSquare(LogicalSquaresIteratorType &iterator) {
+    iterator = m_position.erase(iterator);
+}
 
-void ShapeZ::Rotate() {
-    if (IsLocked()) {
-        return;
+std::unique_ptr<Tetromino> MakeTetromino(IGridLogic &grid_logic,
+                                         const Piece &piece) {
+    assert(piece.orientation == Orientation::north);
+
+    TetrominoPositionType init_position{piece.GetCells()};
+    switch (piece.type) {
+        case TetrominoType::I:
+            return std::make_unique<ShapeI>(grid_logic, init_position);
+        case TetrominoType::J:
+            return std::make_unique<ShapeJ>(grid_logic, init_position);
+        case TetrominoType::L:
+            return std::make_unique<ShapeL>(grid_logic, init_position);
+        case TetrominoType::O:
+            return std::make_unique<ShapeO>(grid_logic, init_position);
+        case TetrominoType::S:
+            return std::make_unique<ShapeS>(grid_logic, init_position);
+        case TetrominoType::T:
+            return std::make_unique<ShapeT>(grid_logic, init_position);
+        case TetrominoType::Z:
+            return std::make_unique<ShapeZ>(grid_logic, init_position);
+        default:
+            return nullptr;
     }
+}
 
-    TetrominoPositionType current_position{GetPosition()};
-    TetrominoPositionType target_position{};
-    switch (m_orientation) {
-        case Orientation::north:
-            target_position =
-                current_position + m_delta_positions.at("NorthEast");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::east;
-            }
-            break;
-        case Orientation::east:
-            target_position =
-                current_position + m_delta_positions.at("EastSouth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::south;
-            }
-            break;
-        case Orientation::south:
-            target_position =
-                current_position + m_delta_positions.at("SouthWest");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::west;
-            }
-            break;
-        case Orientation::west:
-            target_position =
-                current_position + m_delta_positions.at("WestNorth");
-            if (m_grid_logic.RequestSpaceOnGrid(current_position,
-                                                target_position)) {
-                SetPosition(target_position);
-                m_orientation = Orientation::north;
-            }
-            break;
-    }
-}
\ No newline at end of file
+template class Shape<TetrominoType::I>;
+template class Shape<TetrominoType::J>;
+template class Shape<TetrominoType::L>;
+template class Shape<TetrominoType::O>;
+template class Shape<TetrominoType::S>;
+template class Shape<TetrominoType::T>;
+template class Shape<TetrominoType::Z>;
@@ -1,12 +1,13 @@
 #ifndef TETROMINO_H_
 #define TETROMINO_H_
 
-#include <map>
-#include <string>
+#include <memory>
+#include <optional>
 #include <utility>
-#include <vector>
 
 #include "IGridLogic.h"
+#include "Piece.h"
+#include "TetrominoGeometry.h"
 
 enum class Direction { left, right, down };
 
@@ -20,11 +21,26 @@ enum class Color {
     red       // (0xFF0000)
 };
 
-enum class TetrominoType { I, J, L, O, S, T, Z, UNDEFINED };
-
-enum class Orientation { north, east, south, west };
-
-using TetrominoPositionType = std::vector<std::pair<int, int>>;
+/// Retrieves the color of a tetromino type
+/// \param type: type of the tetromino, must not be UNDEFINED
+constexpr Color GetTetrominoColor(TetrominoType type) {
+    switch (type) {
+        case TetrominoType::I:
+            return Color::cyan;
+        case TetrominoType::J:
+            return Color::blue;
+        case TetrominoType::L:
+            return Color::orange;
+        case TetrominoType::O:
+            return Color::yellow;
+        case TetrominoType::S:
+            return Color::green;
+        case TetrominoType::T:
+            return Color::magenta;
+        default:
+            return Color::red;
+    }
+}
 
 using LogicalSquaresIteratorType = TetrominoPositionType::iterator;
 
@@ -33,13 +49,18 @@ TetrominoPositionType operator+(const TetrominoPositionType &position1,
 
 /// Tetromino class is the base class for all seven tetromino shapes. It
 /// provides common properties like color and actions like a move in a certain
-/// direction for all shapes.
+/// direction for all shapes. Space on the logical grid is requested via
+/// IGridLogic::RequestSpaceOnGrid(), so any grid implementation or mock can be
+/// used. Since the game moves its active piece as a Piece value on GridLogic,
+/// see GameCore, tetrominoes only serve the graphical front end.
 class Tetromino {
    public:
     /// No default constructor provided to enforce creating shapes with a fixed
     /// number of squares.
     Tetromino() = delete;
 
+    virtual ~Tetromino() = default;
+
     /// Creates a tetromino consisting of exactly four squares clearly
     /// determined by their positions in the grid.
     /// \param grid_logic:    a reference to the logical grid to determine
@@ -55,7 +76,9 @@ class Tetromino {
 
     /// Retrieves tetrominoes' position.
     /// \return position of every tetromino square
-    virtual TetrominoPositionType GetPosition() const { return m_position; }
+    virtual const TetrominoPositionType &GetPosition() const {
+        return m_position;
+    }
 
     /// SetPositionInDashboard is supposed to be used only to set the tetromino
     /// in the dashboard. Since SetPosition() places shapes on the grid
@@ -63,8 +86,8 @@ class Tetromino {
     /// MoveOneStep() shall be used for game usage instead.
     /// \param target_position: Position in the logical grid at which the
     ///                         Tetromino is to be placed.
-    virtual void SetPosition(TetrominoPositionType target_position) {
-        m_position = std::move(target_position);
+    virtual void SetPosition(const TetrominoPositionType &target_position) {
+        m_position = target_position;
     }
 
     /// Moves the tetromino one step towards a specified direction
@@ -72,6 +95,16 @@ class Tetromino {
     /// \return returns true when the movement was successful, false otherwise.
     virtual bool MoveOneStep(Direction direction);
 
+    /// Moves the tetromino down by several rows at once with a single request
+    /// to the logical grid and locks it down afterwards. This method is
+    /// supposed to be used for hard drops where the number of rows has been
+    /// determined via GridLogic::GetDropDistance() before.
+    /// \param number_rows: number of rows to move down.
+    /// \return returns true when the movement was successful, false otherwise.
+    ///         The tetromino is locked down in both cases unless it has been
+    ///         locked before.
+    virtual bool Drop(int number_rows);
+
     /// Determines whether the tetronimo is locked down or not
     /// \return true if tetromino is locked down and hence unmovable, false
     /// otherwise
@@ -86,6 +119,16 @@ class Tetromino {
     /// Rotates the concrete shape clockwise
     virtual void Rotate() {}
 
+    /// Brings the tetromino back into the state right after its construction
+    /// such that the object can be reused for the next spawn of its shape
+    /// instead of creating a new one. The logical grid is not touched.
+    /// \param init_position: position in the grid where the tetromino is
+    ///                       placed again
+    virtual void Respawn(const TetrominoPositionType &init_position) {
+        m_position = init_position;
+        m_is_locked = false;
+    }
+
     /// Deletes one specified square within the tetromino initially consisting
     /// of four squares. This function is supposed to be used in line clearing
     /// cases.
@@ -100,14 +143,33 @@ class Tetromino {
 
     /// Retrieves the information about the concrete shape. Since the base class
     /// is not meant to represent a concrete shape, its type is undefined.
-    virtual TetrominoType GetTetrominoType() {
+    virtual TetrominoType GetTetrominoType() const {
         return TetrominoType::UNDEFINED;
     };
 
+    /// Retrieves the current orientation of the concrete shape. The base
+    /// class does not rotate, so it always points north.
+    virtual Orientation GetOrientation() const { return Orientation::north; }
+
+    /// Retrieves the piece covering the same cells as the tetromino, e.g. to
+    /// look up its properties in kTetrominoShapeInfos.
+    /// \return the piece, or nothing if the tetromino is not of a concrete
+    ///         type, has lost squares due to line clears or its squares are
+    ///         not ordered like the square offsets of its shape.
+    std::optional<Piece> GetPiece() const;
+
    protected:
     TetrominoPositionType m_position;
     IGridLogic &m_grid_logic;
 
+    /// Rotates the tetromino clockwise by moving its squares as listed in
+    /// kTetrominoRotationDeltas. This is the common implementation of
+    /// Rotate() for all concrete shapes.
+    /// \param type:        type of the concrete shape
+    /// \param orientation: current orientation of the shape, which is set to
+    ///                     the next orientation when the rotation succeeds
+    void RotateClockwise(TetrominoType type, Orientation &orientation);
+
    private:
     Color m_color;
 
@@ -120,146 +182,88 @@ class Tetromino {
     bool m_is_locked;
 };
 
-/// The ShapeI class represents concrete shape I. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeI : public Tetromino {
-   public:
-    ShapeI() = delete;
-    ShapeI(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 0}, {0, 1}, {0, 2}, {0, 3}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
-
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{-2, 2}, {-1, 1}, {0, 0}, {1, -1}}},
-        {"EastSouth", {{2, 1}, {1, 0}, {0, -1}, {-1, -2}}},
-        {"SouthWest", {{1, -2}, {0, -1}, {-1, 0}, {-2, 1}}},
-        {"WestNorth", {{-1, -1}, {0, 0}, {1, 1}, {2, 2}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
-
-/// The ShapeJ class represents concrete shape J. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeJ : public Tetromino {
-   public:
-    ShapeJ() = delete;
-    ShapeJ(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 0}, {1, 0}, {1, 1}, {1, 2}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
-
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{0, 2}, {-1, 1}, {0, 0}, {1, -1}}},
-        {"EastSouth", {{2, 0}, {1, 1}, {0, 0}, {-1, -1}}},
-        {"SouthWest", {{0, -2}, {1, -1}, {0, 0}, {-1, 1}}},
-        {"WestNorth", {{-2, 0}, {-1, -1}, {0, 0}, {1, 1}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
-
-/// The ShapeL class represents concrete shape L. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeL : public Tetromino {
+/// The Shape class represents one concrete shape. Apart from inherited
+/// methods, it provides in addition the shape rotation. The shapes only differ
+/// in the data they look up in the tables of TetrominoGeometry.h.
+template <TetrominoType Type>
+class Shape : public Tetromino {
    public:
-    ShapeL() = delete;
-    ShapeL(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {1, 0}, {1, 1}, {1, 2}, {0, 2}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
+    Shape() = delete;
+
+    /// Creates the shape in the orientation north with the color of its type
+    /// \param grid_logic:    logical grid the shape moves in
+    /// \param init_position: initial position, by default the shape is placed
+    ///                       in the upper left corner of the grid
+    Shape(IGridLogic &grid_logic,
+          TetrominoPositionType init_position = GetDefaultPosition())
+        : Tetromino{grid_logic, init_position, GetTetrominoColor(Type)},
+          m_orientation{Orientation::north} {}
+
+    Orientation GetOrientation() const override { return m_orientation; }
+
+    void Rotate() override {
+        // the O-shape looks the same in every orientation
+        if constexpr (Type != TetrominoType::O) {
+            RotateClockwise(Type, m_orientation);
+        }
+    }
 
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{2, 0}, {-1, 1}, {0, 0}, {1, -1}}},
-        {"EastSouth", {{0, -2}, {1, 1}, {0, 0}, {-1, -1}}},
-        {"SouthWest", {{-2, 0}, {-1, -1}, {0, 0}, {1, 1}}},
-        {"WestNorth", {{0, 2}, {1, -1}, {0, 0}, {-1, 1}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
+    TetrominoType GetTetrominoType() const override { return Type; };
 
-/// The ShapeO class represents concrete shape O. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeO : public Tetromino {
-   public:
-    ShapeO() = delete;
-    ShapeO(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 0}, {0, 1}, {1, 1}, {1, 0}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
+    void Respawn(const TetrominoPositionType &init_position) override {
+        Tetromino::Respawn(init_position);
+        m_orientation = Orientation::north;
+    }
 
    private:
     Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
-
-/// The ShapeS class represents concrete shape S. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeS : public Tetromino {
-   public:
-    ShapeS() = delete;
-    ShapeS(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 1}, {0, 2}, {1, 1}, {1, 0}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
 
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{1, 1}, {2, 0}, {0, 0}, {-1, 1}}},
-        {"EastSouth", {{1, -1}, {0, -2}, {0, 0}, {1, 1}}},
-        {"SouthWest", {{-1, -1}, {-2, 0}, {0, 0}, {1, -1}}},
-        {"WestNorth", {{-1, 1}, {0, 2}, {0, 0}, {-1, -1}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
-
-/// The ShapeT class represents concrete shape T. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeT : public Tetromino {
-   public:
-    ShapeT() = delete;
-    ShapeT(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 1}, {1, 0}, {1, 1}, {1, 2}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
-
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{0, 0}, {0, 2}, {0, 0}, {1, -1}}},
-        {"EastSouth", {{2, 0}, {0, 0}, {0, 0}, {-1, -1}}},
-        {"SouthWest", {{-1, -1}, {1, -1}, {0, 0}, {-1, 1}}},
-        {"WestNorth", {{-1, 1}, {-1, -1}, {0, 0}, {1, 1}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
+    static TetrominoPositionType GetDefaultPosition() {
+        switch (Type) {
+            case TetrominoType::I:
+                return {{0, 0}, {0, 1}, {0, 2}, {0, 3}};
+            case TetrominoType::J:
+                return {{0, 0}, {1, 0}, {1, 1}, {1, 2}};
+            case TetrominoType::L:
+                return {{1, 0}, {1, 1}, {1, 2}, {0, 2}};
+            case TetrominoType::O:
+                return {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+            case TetrominoType::S:
+                return {{0, 1}, {0, 2}, {1, 1}, {1, 0}};
+            case TetrominoType::T:
+                return {{0, 1}, {1, 0}, {1, 1}, {1, 2}};
+            default:
+                return {{0, 0}, {0, 1}, {1, 1}, {1, 2}};
+        }
+    }
 };
 
-/// The ShapeZ class represents concrete shape Z. Apart from inherited methods,
-/// it provides in addition a concrete implementation of the shape rotation.
-class ShapeZ : public Tetromino {
-   public:
-    ShapeZ() = delete;
-    ShapeZ(IGridLogic &grid_logic, TetrominoPositionType init_position = {
-                                       {0, 0}, {0, 1}, {1, 1}, {1, 2}});
-    Orientation GetOrientation() { return m_orientation; }
-    void Rotate() override;
-    TetrominoType GetTetrominoType() override { return m_tetromino_type; };
-
-   private:
-    const std::map<std::string, TetrominoPositionType> m_delta_positions{
-        {"NorthEast", {{0, 2}, {1, 1}, {0, 0}, {1, -1}}},
-        {"EastSouth", {{2, 0}, {1, -1}, {0, 0}, {-1, -1}}},
-        {"SouthWest", {{0, -2}, {-1, -1}, {0, 0}, {-1, 1}}},
-        {"WestNorth", {{-2, 0}, {-1, 1}, {0, 0}, {1, 1}}}};
-    Orientation m_orientation;
-    TetrominoType m_tetromino_type;
-};
+using ShapeI = Shape<TetrominoType::I>;
+using ShapeJ = Shape<TetrominoType::J>;
+using ShapeL = Shape<TetrominoType::L>;
+using ShapeO = Shape<TetrominoType::O>;
+using ShapeS = Shape<TetrominoType::S>;
+using ShapeT = Shape<TetrominoType::T>;
+using ShapeZ = Shape<TetrominoType::Z>;
+
+/// Creates the concrete shape for a piece such that its squares cover the
+/// cells of the piece. The Shape[X] classes serve as a thin adapter of the
+/// piece value type for the graphical front end.
+/// \param grid_logic: logical grid the created tetromino moves in
+/// \param piece:      type and initial position of the tetromino. The
+///                    orientation is expected to be north.
+/// \return the created tetromino, which has not requested any space on the
+///         grid yet
+std::unique_ptr<Tetromino> MakeTetromino(IGridLogic &grid_logic,
+                                         const Piece &piece);
+
+// The shapes are compiled once in Tetromino.cpp
+extern template class Shape<TetrominoType::I>;
+extern template class Shape<TetrominoType::J>;
+extern template class Shape<TetrominoType::L>;
+extern template class Shape<TetrominoType::O>;
+extern template class Shape<TetrominoType::S>;
+extern template class Shape<TetrominoType::T>;
+extern template class Shape<TetrominoType::Z>;
 
 #endif /* TETROMINO_H_ */
@@ -0,0 +1,228 @@
+#ifndef TETROMINO_GEOMETRY_H_
+#define TETROMINO_GEOMETRY_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+enum class TetrominoType { I, J, L, O, S, T, Z, UNDEFINED };
+
+enum class Orientation { north, east, south, west };
+
+constexpr int kNumberTetrominoTypes{7};
+constexpr int kNumberOrientations{4};
+constexpr int kNumberSquaresPerTetromino{4};
+
+/// Offsets of the four squares of a tetromino relative to the top left corner
+/// of the 4x4 box in which the tetromino rotates. The first element of each
+/// pair is the row offset, the second one the column offset.
+using SquareOffsetsType =
+    std::array<std::pair<int, int>, kNumberSquaresPerTetromino>;
+
+/// Table holding four squares for every tetromino type and orientation
+using SquareOffsetsTableType =
+    std::array<std::array<SquareOffsetsType, kNumberOrientations>,
+               kNumberTetrominoTypes>;
+
+/// Square offsets of every tetromino type in every orientation. All
+/// orientations of one type share the same box, so a clockwise rotation only
+/// changes the orientation while the box stays in place. The order of the
+/// squares matches the order used by the Shape[X] classes, i.e. square n of
+/// one orientation is square n of the next orientation after a rotation.
+inline constexpr SquareOffsetsTableType kTetrominoSquareOffsets{{
+    // I-Shape
+    {{{{{2, 0}, {2, 1}, {2, 2}, {2, 3}}},
+      {{{0, 2}, {1, 2}, {2, 2}, {3, 2}}},
+      {{{2, 3}, {2, 2}, {2, 1}, {2, 0}}},
+      {{{3, 1}, {2, 1}, {1, 1}, {0, 1}}}}},
+    // J-Shape
+    {{{{{0, 0}, {1, 0}, {1, 1}, {1, 2}}},
+      {{{0, 2}, {0, 1}, {1, 1}, {2, 1}}},
+      {{{2, 2}, {1, 2}, {1, 1}, {1, 0}}},
+      {{{2, 0}, {2, 1}, {1, 1}, {0, 1}}}}},
+    // L-Shape
+    {{{{{0, 2}, {1, 0}, {1, 1}, {1, 2}}},
+      {{{2, 2}, {0, 1}, {1, 1}, {2, 1}}},
+      {{{2, 0}, {1, 2}, {1, 1}, {1, 0}}},
+      {{{0, 0}, {0, 1}, {1, 1}, {2, 1}}}}},
+    // O-Shape
+    {{{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}},
+      {{{0, 0}, {0, 1}, {1, 1}, {1, 0}}},
+      {{{0, 0}, {0, 1}, {1, 1}, {1, 0}}},
+      {{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}},
+    // S-Shape
+    {{{{{0, 1}, {0, 2}, {1, 1}, {1, 0}}},
+      {{{1, 2}, {2, 2}, {1, 1}, {0, 1}}},
+      {{{2, 1}, {2, 0}, {1, 1}, {1, 2}}},
+      {{{1, 0}, {0, 0}, {1, 1}, {2, 1}}}}},
+    // T-Shape
+    {{{{{0, 1}, {1, 0}, {1, 1}, {1, 2}}},
+      {{{0, 1}, {1, 2}, {1, 1}, {2, 1}}},
+      {{{2, 1}, {1, 2}, {1, 1}, {1, 0}}},
+      {{{1, 0}, {2, 1}, {1, 1}, {0, 1}}}}},
+    // Z-Shape
+    {{{{{0, 0}, {0, 1}, {1, 1}, {1, 2}}},
+      {{{0, 2}, {1, 2}, {1, 1}, {2, 1}}},
+      {{{2, 2}, {2, 1}, {1, 1}, {1, 0}}},
+      {{{2, 0}, {1, 0}, {1, 1}, {0, 1}}}}},
+}};
+
+/// Retrieves the square offsets of a tetromino type in a given orientation.
+/// The type must not be TetrominoType::UNDEFINED.
+constexpr const SquareOffsetsType &GetSquareOffsets(TetrominoType type,
+                                                    Orientation orientation) {
+    return kTetrominoSquareOffsets[static_cast<int>(type)]
+                                  [static_cast<int>(orientation)];
+}
+
+/// Retrieves the orientation a tetromino has after one clockwise rotation.
+constexpr Orientation GetNextClockwiseOrientation(Orientation orientation) {
+    return static_cast<Orientation>((static_cast<int>(orientation) + 1) %
+                                    kNumberOrientations);
+}
+
+namespace tetromino_geometry_detail {
+
+constexpr SquareOffsetsType SubtractSquareOffsets(
+    const SquareOffsetsType &minuend, const SquareOffsetsType &subtrahend) {
+    return {{{minuend[0].first - subtrahend[0].first,
+              minuend[0].second - subtrahend[0].second},
+             {minuend[1].first - subtrahend[1].first,
+              minuend[1].second - subtrahend[1].second},
+             {minuend[2].first - subtrahend[2].first,
+              minuend[2].second - subtrahend[2].second},
+             {minuend[3].first - subtrahend[3].first,
+              minuend[3].second - subtrahend[3].second}}};
+}
+
+constexpr std::array<SquareOffsetsType, kNumberOrientations>
+MakeRotationDeltas(int type) {
+    const auto &offsets{kTetrominoSquareOffsets[type]};
+    return {{SubtractSquareOffsets(offsets[1], offsets[0]),
+             SubtractSquareOffsets(offsets[2], offsets[1]),
+             SubtractSquareOffsets(offsets[3], offsets[2]),
+             SubtractSquareOffsets(offsets[0], offsets[3])}};
+}
+
+constexpr SquareOffsetsTableType MakeRotationDeltasTable() {
+    return {{MakeRotationDeltas(0), MakeRotationDeltas(1),
+             MakeRotationDeltas(2), MakeRotationDeltas(3),
+             MakeRotationDeltas(4), MakeRotationDeltas(5),
+             MakeRotationDeltas(6)}};
+}
+
+}  // namespace tetromino_geometry_detail
+
+/// Movement of every square of a tetromino when it is rotated clockwise from
+/// a given orientation, i.e. square n moves by kTetrominoRotationDeltas[type]
+/// [orientation][n]. The table is derived from kTetrominoSquareOffsets at
+/// compile time.
+inline constexpr SquareOffsetsTableType kTetrominoRotationDeltas{
+    tetromino_geometry_detail::MakeRotationDeltasTable()};
+
+/// Retrieves the movement of every square of a tetromino when it is rotated
+/// clockwise from the given orientation. The type must not be
+/// TetrominoType::UNDEFINED.
+constexpr const SquareOffsetsType &GetRotationDeltas(TetrominoType type,
+                                                     Orientation orientation) {
+    return kTetrominoRotationDeltas[static_cast<int>(type)]
+                                   [static_cast<int>(orientation)];
+}
+
+/// Occupancy of the 4x4 box a tetromino rotates in. Bit 4 * r + c is set when
+/// the square at row offset r and column offset c belongs to the tetromino.
+using BoxMaskType = std::uint16_t;
+
+/// Precomputed properties of one tetromino type in one orientation. Collision
+/// checks, drop distances, the ghost piece and spawn positions are all
+/// derived from these entries instead of the individual square offsets. All
+/// rows and columns are offsets relative to the top left corner of the box.
+struct TetrominoShapeInfo {
+    /// squares in each row of the box, bit n corresponds to box column n
+    std::array<std::uint8_t, kNumberSquaresPerTetromino> row_masks;
+    /// occupancy of the entire box
+    BoxMaskType box_mask;
+    /// bounding box of the squares
+    int top_row;
+    int bottom_row;
+    int left_column;
+    int right_column;
+    /// row of the lowest square in each box column, -1 for empty columns
+    std::array<int, kNumberSquaresPerTetromino> lowest_rows;
+    /// box row of a spawned tetromino such that its top squares are in the
+    /// first row of the grid
+    int spawn_row;
+    /// box column of a spawned tetromino relative to number_columns / 2,
+    /// which centers it on the grid rounded to the left
+    int spawn_column_offset;
+};
+
+/// Table holding the shape properties of every tetromino type and orientation
+using TetrominoShapeInfoTableType =
+    std::array<std::array<TetrominoShapeInfo, kNumberOrientations>,
+               kNumberTetrominoTypes>;
+
+namespace tetromino_geometry_detail {
+
+constexpr TetrominoShapeInfo MakeShapeInfo(const SquareOffsetsType &offsets) {
+    TetrominoShapeInfo info{};
+    info.top_row = kNumberSquaresPerTetromino;
+    info.bottom_row = -1;
+    info.left_column = kNumberSquaresPerTetromino;
+    info.right_column = -1;
+    for (auto &lowest_row : info.lowest_rows) {
+        lowest_row = -1;
+    }
+    for (const auto &offset : offsets) {
+        info.row_masks[offset.first] |=
+            static_cast<std::uint8_t>(1U << offset.second);
+        info.box_mask |=
+            static_cast<BoxMaskType>(1U << (4 * offset.first + offset.second));
+        info.top_row = std::min(info.top_row, offset.first);
+        info.bottom_row = std::max(info.bottom_row, offset.first);
+        info.left_column = std::min(info.left_column, offset.second);
+        info.right_column = std::max(info.right_column, offset.second);
+        info.lowest_rows[offset.second] =
+            std::max(info.lowest_rows[offset.second], offset.first);
+    }
+    int width{info.right_column - info.left_column + 1};
+    info.spawn_row = -info.top_row;
+    info.spawn_column_offset = -(width + 1) / 2 - info.left_column;
+    return info;
+}
+
+constexpr TetrominoShapeInfoTableType MakeShapeInfoTable() {
+    TetrominoShapeInfoTableType table{};
+    for (int type{0}; type < kNumberTetrominoTypes; ++type) {
+        for (int orientation{0}; orientation < kNumberOrientations;
+             ++orientation) {
+            table[type][orientation] =
+                MakeShapeInfo(kTetrominoSquareOffsets[type][orientation]);
+        }
+    }
+    return table;
+}
+
+}  // namespace tetromino_geometry_detail
+
+/// Shape properties of every tetromino type in every orientation, generated
+/// from kTetrominoSquareOffsets at compile time.
+inline constexpr TetrominoShapeInfoTableType kTetrominoShapeInfos{
+    tetromino_geometry_detail::MakeShapeInfoTable()};
+
+/// Retrieves the shape properties of a tetromino type in a given orientation.
+/// The type must not be TetrominoType::UNDEFINED.
+constexpr const TetrominoShapeInfo &GetShapeInfo(TetrominoType type,
+                                                 Orientation orientation) {
+    return kTetrominoShapeInfos[static_cast<int>(type)]
+                               [static_cast<int>(orientation)];
+}
+
+/// Retrieves the box mask of a tetromino type in a given orientation. The
+/// type must not be TetrominoType::UNDEFINED.
+constexpr BoxMaskType GetBoxMask(TetrominoType type, Orientation orientation) {
+    return GetShapeInfo(type, orientation).box_mask;
+}
+
+#endif /* TETROMINO_GEOMETRY_H_ */
@@ -1,38 +1,32 @@
 #include "TetrominoGraphic.h"
 
-#include "GridLogic.h"
+#include <cassert>
 
-TetrominoGraphic::TetrominoGraphic(std::unique_ptr<Tetromino> shape,
-                                   const GridGraphic& grid_graphic)
-    : m_shape{std::move(shape)}, m_grid_graphic{grid_graphic} {
-    sf::Color tetromino_color{sf::Color::Black};
-
-    // map shape-color to sf-color
-    switch (m_shape->GetColor()) {
+sf::Color GetSfColor(Color color) {
+    switch (color) {
         case Color::blue:
-            tetromino_color = sf::Color::Blue;
-            break;
+            return sf::Color::Blue;
         case Color::cyan:
-            tetromino_color = sf::Color::Cyan;
-            break;
+            return sf::Color::Cyan;
         case Color::green:
-            tetromino_color = sf::Color::Green;
-            break;
+            return sf::Color::Green;
         case Color::orange:
-            tetromino_color = sf::Color(255, 165, 0);
-            break;
+            return sf::Color(255, 165, 0);
         case Color::magenta:
-            tetromino_color = sf::Color::Magenta;
-            break;
+            return sf::Color::Magenta;
         case Color::red:
-            tetromino_color = sf::Color::Red;
-            break;
+            return sf::Color::Red;
         case Color::yellow:
-            tetromino_color = sf::Color::Yellow;
-            break;
+            return sf::Color::Yellow;
         default:
-            break;
+            return sf::Color::Black;
     }
+}
+
+TetrominoGraphic::TetrominoGraphic(std::unique_ptr<Tetromino> shape,
+                                   const GridGraphic& grid_graphic)
+    : m_shape{std::move(shape)}, m_grid_graphic{grid_graphic} {
+    sf::Color tetromino_color{GetSfColor(m_shape->GetColor())};
 
     // instantiate rectangles representing the tetromino shape on the
     // GridGraphic with init values like position at x=0, y=0
@@ -52,13 +46,19 @@ bool TetrominoGraphic::MoveOneStep(Direction direction) {
     return is_movement_succeed;
 }
 
+bool TetrominoGraphic::Drop(int number_rows) {
+    bool is_movement_succeed{m_shape->Drop(number_rows)};
+    UpdatePosition();
+    return is_movement_succeed;
+}
+
 void TetrominoGraphic::Rotate() {
     m_shape->Rotate();
     UpdatePosition();
 }
 
 void TetrominoGraphic::UpdatePosition() {
-    auto tetromino_position = m_shape->GetPosition();
+    const auto& tetromino_position = m_shape->GetPosition();
     for (int index{0}; index < m_squares.size(); ++index) {
         int rowindex_in_grid = tetromino_position.at(index).first;
         int columnindex_in_grid = tetromino_position.at(index).second;
@@ -69,14 +69,15 @@ void TetrominoGraphic::UpdatePosition() {
     }
 }
 
-void TetrominoGraphic::DeleteTetrominoSquare(
-    GraphicalSquaresIteratorType& graphical_iterator,
-    LogicalSquaresIteratorType& logical_iterator) {
-    m_shape->DeleteTetrominoSquare(logical_iterator);
-    graphical_iterator = m_squares.erase(graphical_iterator);
+void TetrominoGraphic::Respawn(const Piece& piece) {
+    assert(piece.type == m_shape->GetTetrominoType() &&
+           piece.orientation == Orientation::north);
+    m_shape->Respawn(piece.GetCells());
+    UpdatePosition();
 }
 
-void TetrominoGraphic::SetPositionInDashboard(TetrominoPositionType position) {
+void TetrominoGraphic::SetPositionInDashboard(
+    const TetrominoPositionType& position) {
     m_shape->SetPosition(position);
     UpdatePosition();
 }
@@ -5,9 +5,11 @@
 #include <memory>
 
 #include "GridGraphic.h"
+#include "GridLogic.h"
 #include "Tetromino.h"
 
-using GraphicalSquaresIteratorType = std::vector<sf::RectangleShape>::iterator;
+/// Maps the color of a tetromino to the corresponding SFML color
+sf::Color GetSfColor(Color color);
 
 /// The dashboard provides information to the player about the current game's
 /// state. It shows the queue of the upcoming shapes being drawn as the next
@@ -29,6 +31,12 @@ class TetrominoGraphic : public sf::Drawable {
     /// false otherwise.
     bool MoveOneStep(Direction direction);
 
+    /// wraps the same-named method from the tetromino class to then update the
+    /// actual drawing.
+    /// \param number_rows: number of rows to move down before locking down.
+    /// \return returns true when the movement was successful, false otherwise.
+    bool Drop(int number_rows);
+
     /// Rotates the tetromino clockwise
     void Rotate();
 
@@ -37,46 +45,29 @@ class TetrominoGraphic : public sf::Drawable {
     /// otherwise
     bool IsLocked() const { return m_shape->IsLocked(); }
 
-    /// wraps the same-named method from the tetromino class to then update the
-    /// actual drawing. \param logical_iterator: iterator to the square being
-    /// deleted
-    void DeleteTetrominoSquare(GraphicalSquaresIteratorType& graphical_iterator,
-                               LogicalSquaresIteratorType& logical_iterator);
-
     /// wraps the same-named method from the tetromino class.
     void LockDown() { m_shape->LockDown(); };
 
     /// wraps the same-named method from the tetromino class.
     void Release() { m_shape->Release(); };
 
-    /// Retrieves the iterator to the first square of the Tetromino class object
-    LogicalSquaresIteratorType GetIteratorToBeginOfLogicalTetromino() {
-        return m_shape->GetIteratorToBeginOfPositionVector();
-    };
-
-    /// Retrieves the iterator to the first square of the TetrominoGraphic class
-    /// object
-    GraphicalSquaresIteratorType GetIteratorToBeginOfGraphicalTetromino() {
-        return m_squares.begin();
-    };
-
-    /// Retrieves the iterator to the last square of the TetrominoGraphic class
-    /// object
-    GraphicalSquaresIteratorType GetIteratorToEndOfGraphicalTetromino() {
-        return m_squares.end();
-    };
-
-    /// Retrieves all squares of the TetrominoGraphic class object
-    std::vector<sf::RectangleShape> GetSquares() const { return m_squares; };
-
     /// wraps the same-named method from the tetromino class.
     TetrominoType GetTetrominoType() { return m_shape->GetTetrominoType(); };
 
+    /// wraps the same-named method from the tetromino class.
+    std::optional<Piece> GetPiece() const { return m_shape->GetPiece(); }
+
+    /// Places the tetromino unlocked and in the orientation north at a piece
+    /// as if it has just been created, see TetrominoGraphicPool.
+    /// \param piece: position of the respawned tetromino. Its type must match
+    ///               the type of the tetromino, its orientation must be north.
+    void Respawn(const Piece& piece);
+
     /// This function shall only be used to draw tetrominoes on the dashboard.
-    void SetPositionInDashboard(TetrominoPositionType position);
+    void SetPositionInDashboard(const TetrominoPositionType& position);
 
     /// Retrieves the tetrominoes position relative to logical grid coordinates.
-    TetrominoPositionType GetPositionInGridLogicFrame() {
+    const TetrominoPositionType& GetPositionInGridLogicFrame() const {
         return m_shape->GetPosition();
     }
 
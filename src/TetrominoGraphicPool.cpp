@@ -0,0 +1,33 @@
+#include "TetrominoGraphicPool.h"
+
+std::unique_ptr<TetrominoGraphic> TetrominoGraphicPool::Acquire(
+    GridLogic& grid_logic, const GridGraphic& grid_graphic,
+    const Piece& piece) {
+    std::vector<std::unique_ptr<TetrominoGraphic>>& free_tetrominoes{
+        m_free_tetrominoes[static_cast<int>(piece.type)]};
+    std::unique_ptr<TetrominoGraphic> tetromino;
+    if (free_tetrominoes.empty()) {
+        tetromino = std::make_unique<TetrominoGraphic>(
+            MakeTetromino(grid_logic, piece), grid_graphic);
+        ++m_statistics.number_created;
+    } else {
+        tetromino = std::move(free_tetrominoes.back());
+        free_tetrominoes.pop_back();
+        tetromino->Respawn(piece);
+        ++m_statistics.number_reused;
+        --m_statistics.number_free;
+    }
+    ++m_statistics.number_in_use;
+    return tetromino;
+}
+
+void TetrominoGraphicPool::Release(
+    std::unique_ptr<TetrominoGraphic> tetromino) {
+    if (!tetromino) {
+        return;
+    }
+    int type{static_cast<int>(tetromino->GetTetrominoType())};
+    m_free_tetrominoes[type].push_back(std::move(tetromino));
+    --m_statistics.number_in_use;
+    ++m_statistics.number_free;
+}
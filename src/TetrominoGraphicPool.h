@@ -0,0 +1,64 @@
+#ifndef TETROMINO_GRAPHIC_POOL_H_
+#define TETROMINO_GRAPHIC_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "GridGraphic.h"
+#include "GridLogic.h"
+#include "Piece.h"
+#include "TetrominoGraphic.h"
+
+/// Usage statistics of a TetrominoGraphicPool
+struct TetrominoPoolStatistics {
+    /// number of tetrominoes created on the heap so far
+    std::size_t number_created{0};
+    /// number of acquisitions served by a released tetromino
+    std::size_t number_reused{0};
+    /// number of tetrominoes acquired and not released yet
+    std::size_t number_in_use{0};
+    /// number of released tetrominoes waiting to be reused
+    std::size_t number_free{0};
+};
+
+/// The TetrominoGraphicPool class recycles the graphical tetrominoes together
+/// with their logical tetromino and squares. Released tetrominoes are kept in
+/// one free list per shape and respawned on the next acquisition of the same
+/// shape, so once every shape has been created often enough to cover the
+/// tetrominoes alive at the same time, spawning allocates nothing. A pool is
+/// meant to serve a single grid, the grid passed to Acquire() is only used
+/// when a new tetromino has to be created.
+class TetrominoGraphicPool {
+   public:
+    /// Retrieves a tetromino placed at a piece, either a released one of the
+    /// same shape or a newly created one.
+    /// \param grid_logic:   logical grid the tetromino moves in
+    /// \param grid_graphic: grid in which the tetromino is being drawn
+    /// \param piece:        type and initial position of the tetromino. The
+    ///                      orientation is expected to be north.
+    /// \return the tetromino, which has not requested any space on the grid
+    std::unique_ptr<TetrominoGraphic> Acquire(GridLogic& grid_logic,
+                                              const GridGraphic& grid_graphic,
+                                              const Piece& piece);
+
+    /// Hands a tetromino back to the pool for later reuse. Space the
+    /// tetromino occupies on the logical grid stays occupied.
+    /// \param tetromino: tetromino acquired from this pool before, nothing
+    ///                   happens if it is empty
+    void Release(std::unique_ptr<TetrominoGraphic> tetromino);
+
+    /// Retrieves how many tetrominoes have been created, reused etc.
+    const TetrominoPoolStatistics& GetStatistics() const {
+        return m_statistics;
+    }
+
+   private:
+    std::array<std::vector<std::unique_ptr<TetrominoGraphic>>,
+               kNumberTetrominoTypes>
+        m_free_tetrominoes{};
+    TetrominoPoolStatistics m_statistics{};
+};
+
+#endif /* TETROMINO_GRAPHIC_POOL_H_ */
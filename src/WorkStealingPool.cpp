@@ -0,0 +1,123 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int number_threads)
+    : m_task_ranges(static_cast<std::size_t>(std::max(number_threads, 1))) {
+    for (int worker_index{0}; worker_index < std::max(number_threads, 1);
+         ++worker_index) {
+        m_threads.emplace_back(&WorkStealingPool::RunWorker, this,
+                               worker_index);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_start_condition.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::Run(std::size_t number_tasks, const TaskType &task) {
+    if (number_tasks == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    // hand out contiguous ranges of equal size, the first ranges take one
+    // task more if the tasks cannot be split evenly
+    std::size_t number_workers{m_task_ranges.size()};
+    std::size_t begin{0};
+    for (std::size_t worker_index{0}; worker_index < number_workers;
+         ++worker_index) {
+        std::size_t size{number_tasks / number_workers +
+                         (worker_index < number_tasks % number_workers ? 1
+                                                                       : 0)};
+        std::lock_guard<std::mutex> range_lock{
+            m_task_ranges[worker_index].mutex};
+        m_task_ranges[worker_index].begin = begin;
+        m_task_ranges[worker_index].end = begin + size;
+        begin += size;
+    }
+
+    m_task = &task;
+    m_number_busy_workers = static_cast<int>(number_workers);
+    ++m_batch_number;
+    m_start_condition.notify_all();
+    m_done_condition.wait(lock, [this] { return m_number_busy_workers == 0; });
+    m_task = nullptr;
+}
+
+void WorkStealingPool::RunWorker(int worker_index) {
+    std::uint64_t last_batch_number{0};
+    while (true) {
+        const TaskType *task{nullptr};
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_start_condition.wait(lock, [this, last_batch_number] {
+                return m_is_stopping || m_batch_number != last_batch_number;
+            });
+            if (m_is_stopping) {
+                return;
+            }
+            last_batch_number = m_batch_number;
+            task = m_task;
+        }
+
+        std::size_t task_index{0};
+        while (TakeTask(worker_index, task_index)) {
+            (*task)(task_index, worker_index);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            --m_number_busy_workers;
+        }
+        m_done_condition.notify_one();
+    }
+}
+
+bool WorkStealingPool::TakeTask(int worker_index, std::size_t &task_index) {
+    TaskRange &range{m_task_ranges[worker_index]};
+    // the stolen tasks may be stolen in turn before they are taken, so keep
+    // stealing until a task is taken or all ranges are empty
+    do {
+        std::lock_guard<std::mutex> lock{range.mutex};
+        if (range.begin != range.end) {
+            task_index = range.begin++;
+            return true;
+        }
+    } while (StealTasks(worker_index));
+    return false;
+}
+
+bool WorkStealingPool::StealTasks(int worker_index) {
+    int number_workers{static_cast<int>(m_task_ranges.size())};
+    for (int offset{1}; offset < number_workers; ++offset) {
+        TaskRange &victim{m_task_ranges[(worker_index + offset) %
+                                        number_workers]};
+        std::size_t begin{0};
+        std::size_t end{0};
+        {
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            if (victim.begin == victim.end) {
+                continue;
+            }
+            // leave the front half to the victim, which is working on it
+            std::size_t middle{victim.begin + (victim.end - victim.begin) / 2};
+            begin = middle;
+            end = victim.end;
+            victim.end = middle;
+        }
+        TaskRange &range{m_task_ranges[worker_index]};
+        std::lock_guard<std::mutex> lock{range.mutex};
+        range.begin = begin;
+        range.end = end;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,84 @@
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// The WorkStealingPool class runs batches of independent tasks on a fixed
+/// set of worker threads. The tasks of a batch are identified by their index
+/// and split into one contiguous range per worker up front. Every worker
+/// processes its own range from the front and, once it runs dry, steals the
+/// back half of the range of another worker. Hence workers only contend for
+/// a range when stealing, and batches of tasks with very different run times
+/// keep all workers busy until the very end.
+class WorkStealingPool {
+   public:
+    /// Task of a batch
+    /// \param task_index:   index of the task within the batch
+    /// \param worker_index: index of the worker running the task, from 0 to
+    ///                      GetNumberOfThreads() - 1, e.g. to access per
+    ///                      worker data without locking
+    using TaskType =
+        std::function<void(std::size_t task_index, int worker_index)>;
+
+    /// Starts the worker threads, which wait for the first batch.
+    /// \param number_threads: number of worker threads, at least 1
+    explicit WorkStealingPool(int number_threads);
+
+    /// Stops and joins the worker threads.
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /// Retrieves the number of worker threads.
+    int GetNumberOfThreads() const {
+        return static_cast<int>(m_threads.size());
+    }
+
+    /// Runs a batch of tasks and waits until all of them have finished. The
+    /// tasks are expected not to throw.
+    /// \param number_tasks: number of tasks, the task indexes run from 0 to
+    ///                      number_tasks - 1
+    /// \param task:         task being called once per task index
+    void Run(std::size_t number_tasks, const TaskType &task);
+
+   private:
+    // range of task indexes not taken yet, aligned to not share a cache line
+    // with the range of another worker
+    struct alignas(64) TaskRange {
+        std::mutex mutex;
+        std::size_t begin{0};
+        std::size_t end{0};
+    };
+
+    std::vector<std::thread> m_threads;
+    std::vector<TaskRange> m_task_ranges;
+    std::mutex m_mutex;
+    std::condition_variable m_start_condition;
+    std::condition_variable m_done_condition;
+    const TaskType *m_task{nullptr};
+    std::uint64_t m_batch_number{0};
+    int m_number_busy_workers{0};
+    bool m_is_stopping{false};
+
+    /// Waits for batches and processes them until the pool is stopped.
+    void RunWorker(int worker_index);
+
+    /// Takes the next task index from the range of a worker, stealing tasks
+    /// from the other workers if the range is empty.
+    /// \return false if the ranges of all workers are empty
+    bool TakeTask(int worker_index, std::size_t &task_index);
+
+    /// Moves the back half of the range of another worker into the empty
+    /// range of a worker, trying the other workers one after another.
+    /// \return false if all ranges are empty
+    bool StealTasks(int worker_index);
+};
+
+#endif /* WORK_STEALING_POOL_H_ */
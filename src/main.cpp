@@ -1,13 +1,56 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
 #include "Controller.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+    // the playfield dimensions can optionally be passed as
+    // TetrisApp <number_rows> <number_columns>, followed by
+    // --record <replay_file> to record all inputs for TetrisSim --replay
+    // and --resume <state_file> to continue the game saved in the file.
+    // Any other or incomplete argument is rejected instead of being ignored.
+    const std::string usage{
+        std::string{"Usage: "} + argv[0] +
+        " [<number_rows> <number_columns>] [--record <replay_file>] "
+        "[--resume <state_file>], both dimensions at least 4"};
+    std::string replay_path;
+    std::string state_path;
+    std::vector<std::string> dimensions;
+    for (int index{1}; index < argc; ++index) {
+        std::string argument{argv[index]};
+        if (argument == "--record" && index + 1 < argc) {
+            replay_path = argv[++index];
+        } else if (argument == "--resume" && index + 1 < argc) {
+            state_path = argv[++index];
+        } else if (argument.rfind("--", 0) != 0 && dimensions.size() < 2) {
+            dimensions.push_back(argument);
+        } else {
+            std::cerr << usage << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    int number_rows{20};
+    int number_columns{10};
+    if (!dimensions.empty()) {
+        number_rows = std::atoi(dimensions[0].c_str());
+        number_columns =
+            dimensions.size() == 2 ? std::atoi(dimensions[1].c_str()) : 0;
+        if (number_rows < 4 || number_columns < 4) {
+            std::cerr << usage << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
     sf::RenderWindow window(sf::VideoMode(700, 1000), "Tetris");
 
     sf::Font font;
     if (font.loadFromFile("src/Gasalt-Regular.ttf")) {
-        Controller controller(window, font);
+        Controller controller(window, font, number_rows, number_columns,
+                              replay_path, state_path);
         controller.StartGame(window);
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
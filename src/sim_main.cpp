@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "BatchSimulator.h"
+#include "Replay.h"
+
+// Plays a batch of games without a display and reports the throughput and
+// the outcome of the games, see PrintUsage() for the options.
+
+namespace {
+
+void PrintUsage(const char *program_name) {
+    std::cerr
+        << "Usage: " << program_name << " [options]\n"
+        << "  --games <n>           number of games, default 1000\n"
+        << "  --threads <n>         number of worker threads, default all "
+           "cores\n"
+        << "  --seed <n>            seed of the first game, default 1\n"
+        << "  --policy <name>       greedy (default) or random\n"
+        << "  --randomizer <name>   uniform (default), bag or history\n"
+        << "  --gravity <name>      line (default) or cascade\n"
+        << "  --max-pieces <n>      pieces after which a game ends, default "
+           "1000\n"
+        << "  --rows <n>            number of grid rows, default 20\n"
+        << "  --columns <n>         number of grid columns, default 10\n"
+        << "  --preview <n>         number of next tetrominoes, 1 to 14, "
+           "default 3\n"
+        << "  --replay <file>       plays a replay recorded by TetrisApp "
+           "--record\n"
+        << "                        back and checks it, ignoring all other "
+           "options"
+        << std::endl;
+}
+
+// Writes a rate, or "n/a" if the rate could not be measured
+void PrintRate(std::ostream &stream, const std::optional<double> &rate) {
+    if (rate) {
+        stream << *rate;
+    } else {
+        stream << "n/a";
+    }
+}
+
+int PlayReplayFile(const std::string &path) {
+    Replay replay;
+    if (!LoadReplay(path, replay)) {
+        std::cerr << "Could not read a replay from " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto start{std::chrono::steady_clock::now()};
+    ReplayResult result{PlayReplay(replay)};
+    std::chrono::duration<double> duration{std::chrono::steady_clock::now() -
+                                           start};
+
+    std::cout << "ticks: " << result.number_ticks
+              << ", inputs: " << replay.events.size()
+              << ", score: " << result.score
+              << ", seconds: " << duration.count() << "\n"
+              << std::scientific << std::setprecision(3) << "ticks/s: ";
+    PrintRate(std::cout, ComputeRatePerSecond(
+                             static_cast<double>(result.number_ticks),
+                             duration.count()));
+    std::cout << std::defaultfloat << std::endl;
+    if (!result.is_identical) {
+        std::cout << "state deviates from the recording, detected after tick "
+                  << result.mismatch_detection_tick << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "final state identical, hash " << std::hex
+              << result.final_state_hash << std::dec << std::endl;
+    return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    SimulationSettings settings;
+    settings.number_threads =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::string policy_name{"greedy"};
+
+    for (int index{1}; index < argc; ++index) {
+        std::string option{argv[index]};
+        if (index + 1 >= argc) {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        std::string value{argv[++index]};
+        if (option == "--games") {
+            settings.number_games = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (option == "--threads") {
+            settings.number_threads = std::atoi(value.c_str());
+        } else if (option == "--seed") {
+            settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (option == "--policy" &&
+                   (value == "greedy" || value == "random")) {
+            policy_name = value;
+        } else if (option == "--randomizer" && value == "uniform") {
+            settings.randomizer_policy = RandomizerPolicy::uniform;
+        } else if (option == "--randomizer" && value == "bag") {
+            settings.randomizer_policy = RandomizerPolicy::bag;
+        } else if (option == "--randomizer" && value == "history") {
+            settings.randomizer_policy = RandomizerPolicy::history;
+        } else if (option == "--gravity" && value == "line") {
+            settings.gravity_mode = GravityMode::line;
+        } else if (option == "--gravity" && value == "cascade") {
+            settings.gravity_mode = GravityMode::cascade;
+        } else if (option == "--max-pieces") {
+            settings.max_number_pieces = std::atol(value.c_str());
+        } else if (option == "--rows") {
+            settings.number_grid_rows = std::atoi(value.c_str());
+        } else if (option == "--columns") {
+            settings.number_grid_columns = std::atoi(value.c_str());
+        } else if (option == "--preview") {
+            settings.preview_length = std::atoi(value.c_str());
+        } else if (option == "--replay") {
+            return PlayReplayFile(value);
+        } else {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (settings.number_threads < 1 || settings.number_grid_rows < 4 ||
+        settings.number_grid_columns < 4 ||
+        settings.preview_length < PieceQueue::kMinLength ||
+        settings.preview_length > PieceQueue::kMaxLength) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    BatchSimulator simulator{
+        settings, [&policy_name]() -> std::unique_ptr<IInputPolicy> {
+            if (policy_name == "random") {
+                return std::make_unique<RandomInputPolicy>();
+            }
+            return std::make_unique<GreedyInputPolicy>();
+        }};
+    SimulationReport report{simulator.Run()};
+
+    const SimulationStatistics &statistics{report.statistics};
+    std::optional<double> games_per_second{ComputeRatePerSecond(
+        static_cast<double>(statistics.number_games),
+        report.duration_seconds)};
+    std::optional<double> pieces_per_second{ComputeRatePerSecond(
+        static_cast<double>(statistics.number_pieces),
+        report.duration_seconds)};
+    auto per_thread = [&report](const std::optional<double> &rate) {
+        return rate ? std::optional<double>{*rate / report.number_threads}
+                    : std::nullopt;
+    };
+    double number_games{
+        static_cast<double>(std::max<std::size_t>(statistics.number_games, 1))};
+    std::cout << "games: " << statistics.number_games
+              << ", over: " << statistics.number_games_over
+              << ", threads: " << report.number_threads
+              << ", seconds: " << report.duration_seconds << "\n"
+              << std::scientific << std::setprecision(3) << "games/s: ";
+    PrintRate(std::cout, games_per_second);
+    std::cout << ", per thread: ";
+    PrintRate(std::cout, per_thread(games_per_second));
+    std::cout << "\npieces/s: ";
+    PrintRate(std::cout, pieces_per_second);
+    std::cout << ", per thread: ";
+    PrintRate(std::cout, per_thread(pieces_per_second));
+    std::cout << "\n"
+              << std::defaultfloat
+              << "mean score: " << statistics.total_score / number_games
+              << ", max score: " << statistics.max_score
+              << ", mean cleared lines: "
+              << statistics.number_cleared_lines / number_games
+              << ", mean pieces: " << statistics.number_pieces / number_games
+              << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+#include <memory>
+
+#include "../src/BatchSimulator.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<IInputPolicy> CreateGreedyPolicy() {
+    return std::make_unique<GreedyInputPolicy>();
+}
+
+std::unique_ptr<IInputPolicy> CreateRandomPolicy() {
+    return std::make_unique<RandomInputPolicy>();
+}
+
+}  // namespace
+
+class BatchSimulatorTest : public ::testing::Test {
+   protected:
+    BatchSimulatorTest() {
+        settings.number_games = 40;
+        settings.seed = 77;
+        settings.max_number_pieces = 200;
+    };
+    SimulationSettings settings;
+};
+
+TEST_F(BatchSimulatorTest, ResultsDoNotDependOnTheNumberOfThreads) {
+    settings.number_threads = 1;
+    SimulationReport single_thread_report{
+        BatchSimulator{settings, CreateGreedyPolicy}.Run()};
+    settings.number_threads = 4;
+    SimulationReport report{BatchSimulator{settings, CreateGreedyPolicy}.Run()};
+
+    ASSERT_EQ(settings.number_games, report.game_results.size());
+    for (std::size_t index{0}; index < report.game_results.size(); ++index) {
+        const GameResult &expected{single_thread_report.game_results[index]};
+        const GameResult &actual{report.game_results[index]};
+        EXPECT_EQ(settings.seed + index, actual.seed);
+        EXPECT_EQ(expected.score, actual.score);
+        EXPECT_EQ(expected.number_pieces, actual.number_pieces);
+        EXPECT_EQ(expected.number_ticks, actual.number_ticks);
+    }
+    EXPECT_EQ(4, report.number_threads);
+    EXPECT_EQ(single_thread_report.statistics.total_score,
+              report.statistics.total_score);
+}
+
+TEST_F(BatchSimulatorTest, StatisticsAddUpTheGameResults) {
+    settings.number_threads = 3;
+    SimulationReport report{BatchSimulator{settings, CreateRandomPolicy}.Run()};
+
+    SimulationStatistics expected_statistics;
+    for (const GameResult &result : report.game_results) {
+        expected_statistics.Add(result);
+    }
+    EXPECT_EQ(settings.number_games, report.statistics.number_games);
+    EXPECT_EQ(expected_statistics.number_games_over,
+              report.statistics.number_games_over);
+    EXPECT_EQ(expected_statistics.number_pieces,
+              report.statistics.number_pieces);
+    EXPECT_EQ(expected_statistics.number_ticks, report.statistics.number_ticks);
+    EXPECT_EQ(expected_statistics.total_score, report.statistics.total_score);
+    EXPECT_EQ(expected_statistics.max_score, report.statistics.max_score);
+}
+
+TEST_F(BatchSimulatorTest, GreedyPolicyOutlastsRandomPolicy) {
+    settings.number_threads = 2;
+    SimulationReport random_report{
+        BatchSimulator{settings, CreateRandomPolicy}.Run()};
+    SimulationReport greedy_report{
+        BatchSimulator{settings, CreateGreedyPolicy}.Run()};
+
+    EXPECT_EQ(settings.number_games,
+              random_report.statistics.number_games_over);
+    EXPECT_LT(2 * random_report.statistics.number_pieces,
+              greedy_report.statistics.number_pieces);
+    EXPECT_LT(0, greedy_report.statistics.number_cleared_lines);
+}
+
+TEST(GreedyInputPolicyTest, PlacesFirstPieceWithoutHoles) {
+    GameCore game_core{20, 10, GravityMode::line, PieceRandomizer{5}};
+    GreedyInputPolicy unit;
+    unit.Reset(5);
+
+    StepResult result;
+    for (int step{0}; step < 20 && !result.is_piece_locked; ++step) {
+        result = game_core.Step(unit.GetNextInput(game_core));
+    }
+
+    // the new active piece leaves holes below itself, so look for free cells
+    // below the locked cells only
+    ASSERT_TRUE(result.is_piece_locked);
+    const GridLogic &grid_logic{game_core.GetGridLogic()};
+    int number_locked_cells{0};
+    grid_logic.ForEachLockedCell(
+        [&grid_logic, &number_locked_cells](int row, int column,
+                                            TetrominoType /*type*/) {
+            ++number_locked_cells;
+            for (int row_below{row + 1};
+                 row_below < grid_logic.GetNumberOfRows(); ++row_below) {
+                EXPECT_TRUE(grid_logic.IsCellOccupied(row_below, column));
+            }
+        });
+    EXPECT_EQ(kNumberSquaresPerTetromino, number_locked_cells);
+}
@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../src/ByteStream.h"
+#include "../src/GameCore.h"
+#include "../src/InputPolicy.h"
+#include "gtest/gtest.h"
+
+class GameCoreTest : public ::testing::Test {
+   protected:
+    GameCoreTest()
+        : unit{number_rows, number_columns, GravityMode::line,
+               PieceRandomizer{seed}} {};
+    std::uint64_t seed{1234};
+    int number_rows{20};
+    int number_columns{10};
+
+    GameCore unit;
+
+    // counts the locked cells of a type in a row
+    int CountLockedCells(int row, TetrominoType type) const {
+        int number_cells{0};
+        for (int column{0}; column < number_columns; ++column) {
+            if (unit.GetGridLogic().GetCellType(row, column) == type) {
+                ++number_cells;
+            }
+        }
+        return number_cells;
+    }
+
+    // restores a game whose active piece is an upright I in the first rows of
+    // column 0, and whose given rows are locked apart from column 0, so a
+    // hard drop fills these rows
+    void RestoreUprightIAboveRows(const std::vector<int> &full_rows) {
+        std::vector<std::pair<int, int>> locked_cells;
+        for (int row : full_rows) {
+            for (int column{1}; column < number_columns; ++column) {
+                locked_cells.emplace_back(row, column);
+            }
+        }
+        RestoreUprightIAboveCells(unit, locked_cells);
+    }
+
+    // restores a game whose active piece is an upright I in the first rows of
+    // column 0, and whose only locked cells are the given ones
+    void RestoreUprightIAboveCells(
+        GameCore &game,
+        const std::vector<std::pair<int, int>> &locked_cells) {
+        std::vector<std::uint8_t> state;
+        game.SaveState(state);
+        std::vector<std::uint8_t> randomizer_state;
+        ByteWriter writer{randomizer_state};
+        game.GetPieceRandomizer().WriteState(writer);
+
+        // the active piece follows the magic, the version, the gravity mode,
+        // the grid dimensions and the randomizer
+        Piece piece{MakePiece(TetrominoType::I, Orientation::east, 0, 0)};
+        piece = piece.Translated(-piece.GetShapeInfo().top_row,
+                                 -piece.GetShapeInfo().left_column);
+        std::size_t piece_offset{10 + randomizer_state.size()};
+        state[piece_offset] = static_cast<std::uint8_t>(piece.type);
+        state[piece_offset + 1] = static_cast<std::uint8_t>(piece.orientation);
+        for (int byte{0}; byte < 2; ++byte) {
+            state[piece_offset + 2 + byte] =
+                static_cast<std::uint8_t>(piece.row >> (8 * byte));
+            state[piece_offset + 4 + byte] =
+                static_cast<std::uint8_t>(piece.column >> (8 * byte));
+        }
+
+        std::size_t cells_size{game.GetGridLogic().GetPackedCellsSize()};
+        std::uint8_t *bits{state.data() + state.size() - cells_size};
+        std::uint8_t *types{bits + game.GetGridLogic().GetPackedBitsSize()};
+        std::fill(bits, types, 0);
+        std::fill(types, state.data() + state.size(), 0x77);
+        auto occupy = [&](int row, int column, TetrominoType type) {
+            std::size_t index{
+                static_cast<std::size_t>(row * number_columns + column)};
+            bits[index / 8] |= static_cast<std::uint8_t>(1U << (index % 8));
+            types[index / 2] = static_cast<std::uint8_t>(
+                (types[index / 2] & ~(0xFU << (4 * (index % 2)))) |
+                (static_cast<unsigned>(type) << (4 * (index % 2))));
+        };
+        for (const auto &cell : piece.GetCells()) {
+            occupy(cell.first, cell.second, TetrominoType::UNDEFINED);
+        }
+        for (const auto &cell : locked_cells) {
+            occupy(cell.first, cell.second, TetrominoType::O);
+        }
+        ASSERT_TRUE(game.RestoreState(state.data(), state.size()));
+        ASSERT_EQ(piece, game.GetActivePiece());
+    }
+};
+
+TEST_F(GameCoreTest, NewGameSpawnsActivePieceCenteredInFirstRow) {
+    const Piece &active_piece{unit.GetActivePiece()};
+
+    EXPECT_EQ(MakeSpawnPiece(active_piece.type, number_columns), active_piece);
+    for (const auto &cell : active_piece.GetCells()) {
+        EXPECT_TRUE(
+            unit.GetGridLogic().IsCellOccupied(cell.first, cell.second));
+    }
+    EXPECT_FALSE(unit.IsGameOver());
+    EXPECT_EQ(0, unit.GetScore());
+    EXPECT_EQ(0, unit.GetNumberOfClearedLines());
+}
+
+TEST_F(GameCoreTest, InputsMoveAndRotateActivePiece) {
+    Piece expected_piece{unit.GetActivePiece()};
+
+    EXPECT_FALSE(unit.Step(GameInput::move_down).is_piece_locked);
+    EXPECT_FALSE(unit.Step(GameInput::move_down).is_piece_locked);
+    expected_piece = expected_piece.Translated(2, 0);
+    EXPECT_EQ(expected_piece, unit.GetActivePiece());
+
+    unit.Step(GameInput::move_left);
+    unit.Step(GameInput::move_left);
+    unit.Step(GameInput::move_right);
+    expected_piece = expected_piece.Translated(0, -1);
+    EXPECT_EQ(expected_piece, unit.GetActivePiece());
+
+    unit.Step(GameInput::rotate);
+    EXPECT_EQ(expected_piece.RotatedClockwise(), unit.GetActivePiece());
+
+    unit.Step(GameInput::none);
+    EXPECT_EQ(expected_piece.RotatedClockwise(), unit.GetActivePiece());
+}
+
+TEST_F(GameCoreTest, HardDropLocksActivePieceAndSpawnsNextOne) {
+    TetrominoType dropped_type{unit.GetActivePiece().type};
+    PieceQueue next_tetrominoes{unit.GetNextTetrominoes()};
+    int ghost_drop_distance{unit.GetGhostDropDistance()};
+    EXPECT_LT(0, ghost_drop_distance);
+
+    StepResult result{unit.Step(GameInput::hard_drop)};
+
+    EXPECT_TRUE(result.is_piece_locked);
+    EXPECT_FALSE(result.is_game_over);
+    EXPECT_EQ(0, result.number_cleared_lines);
+    EXPECT_LT(0, CountLockedCells(number_rows - 1, dropped_type));
+    EXPECT_EQ(MakeSpawnPiece(next_tetrominoes[0], number_columns),
+              unit.GetActivePiece());
+    EXPECT_EQ(next_tetrominoes[1], unit.GetNextTetrominoes()[0]);
+    EXPECT_EQ(next_tetrominoes[2], unit.GetNextTetrominoes()[1]);
+}
+
+TEST_F(GameCoreTest, BlockedStepDownLocksActivePiece) {
+    int ghost_drop_distance{unit.GetGhostDropDistance()};
+    for (int step{0}; step < ghost_drop_distance; ++step) {
+        ASSERT_FALSE(unit.Step(GameInput::move_down).is_piece_locked);
+    }
+    EXPECT_EQ(0, unit.GetGhostDropDistance());
+
+    EXPECT_TRUE(unit.Step(GameInput::move_down).is_piece_locked);
+}
+
+TEST_F(GameCoreTest, InputsAreIgnoredAfterGameOverExceptNewGame) {
+    // stack all pieces in the middle until they reach the first row
+    StepResult result;
+    for (int step{0}; step < 10 * number_rows && !result.is_game_over;
+         ++step) {
+        result = unit.Step(GameInput::hard_drop);
+    }
+    ASSERT_TRUE(result.is_game_over);
+    ASSERT_TRUE(unit.IsGameOver());
+    Piece last_piece{unit.GetActivePiece()};
+
+    result = unit.Step(GameInput::move_left);
+
+    EXPECT_TRUE(result.is_game_over);
+    EXPECT_EQ(last_piece, unit.GetActivePiece());
+    EXPECT_EQ(0, unit.GetGhostDropDistance());
+
+    result = unit.Step(GameInput::new_game);
+
+    EXPECT_FALSE(result.is_game_over);
+    EXPECT_FALSE(unit.IsGameOver());
+    EXPECT_TRUE(unit.GetGridLogic().IsRowEmpty(number_rows - 1));
+    EXPECT_EQ(MakeSpawnPiece(unit.GetActivePiece().type, number_columns),
+              unit.GetActivePiece());
+}
+
+TEST_F(GameCoreTest, GamesWithTheSameSeedAreIdentical) {
+    GameCore other_unit{number_rows, number_columns, GravityMode::line,
+                        PieceRandomizer{seed}};
+    PieceRandomizer upcoming_types{unit.GetPieceRandomizer()};
+
+    for (int step{0}; step < 50; ++step) {
+        unit.Step(GameInput::hard_drop);
+        other_unit.Step(GameInput::hard_drop);
+        ASSERT_EQ(unit.GetActivePiece(), other_unit.GetActivePiece());
+        ASSERT_EQ(unit.GetNextTetrominoes(), other_unit.GetNextTetrominoes());
+        if (unit.IsGameOver()) {
+            break;
+        }
+        EXPECT_EQ(upcoming_types.Next(), unit.GetNextTetrominoes().back());
+    }
+}
+
+TEST_F(GameCoreTest, RestoredGameContinuesIdentically) {
+    for (int step{0}; step < 40; ++step) {
+        unit.Step(step % 4 == 0 ? GameInput::hard_drop : GameInput::move_right);
+    }
+    std::vector<std::uint8_t> state;
+    unit.SaveState(state);
+    GameCore other_unit{number_rows, number_columns, GravityMode::line,
+                        PieceRandomizer{seed + 1}};
+
+    ASSERT_TRUE(other_unit.RestoreState(state.data(), state.size()));
+    EXPECT_EQ(unit.ComputeStateHash(), other_unit.ComputeStateHash());
+    for (int step{0}; step < 200 && !unit.IsGameOver(); ++step) {
+        GameInput input{step % 3 == 0 ? GameInput::hard_drop
+                                      : GameInput::rotate};
+        unit.Step(input);
+        other_unit.Step(input);
+        ASSERT_EQ(unit.ComputeStateHash(), other_unit.ComputeStateHash());
+    }
+    EXPECT_EQ(unit.GetScore(), other_unit.GetScore());
+    EXPECT_EQ(unit.GetNextTetrominoes(), other_unit.GetNextTetrominoes());
+}
+
+TEST_F(GameCoreTest, SavedStateIsCompact) {
+    std::vector<std::uint8_t> state;
+    unit.SaveState(state);
+
+    // 200 cells take 25 bytes of occupancy and 100 bytes of types
+    EXPECT_GE(180u, state.size());
+}
+
+TEST_F(GameCoreTest, SingleLineClearScores40) {
+    RestoreUprightIAboveRows({number_rows - 1});
+
+    StepResult result{unit.Step(GameInput::hard_drop)};
+
+    EXPECT_EQ(1, result.number_cleared_lines);
+    EXPECT_EQ(40, result.score_gained);
+    EXPECT_EQ(40, unit.GetScore());
+    EXPECT_EQ(1, unit.GetNumberOfClearedLines());
+}
+
+TEST_F(GameCoreTest, TetrisScores1200) {
+    RestoreUprightIAboveRows({number_rows - 4, number_rows - 3,
+                              number_rows - 2, number_rows - 1});
+
+    StepResult result{unit.Step(GameInput::hard_drop)};
+
+    EXPECT_EQ(4, result.number_cleared_lines);
+    EXPECT_EQ(1200, result.score_gained);
+    EXPECT_EQ(4, unit.GetNumberOfClearedLines());
+}
+
+TEST_F(GameCoreTest, SplitLineClearScoresEachRunOfAdjacentRows) {
+    RestoreUprightIAboveRows({number_rows - 3, number_rows - 1});
+
+    StepResult result{unit.Step(GameInput::hard_drop)};
+
+    // two singles, not one double
+    EXPECT_EQ(2, result.number_cleared_lines);
+    EXPECT_EQ(80, result.score_gained);
+    EXPECT_EQ(2, unit.GetNumberOfClearedLines());
+}
+
+TEST_F(GameCoreTest, CascadeFillingMoreThanFourRowsScoresEveryRow) {
+    GameCore cascade_unit{number_rows, number_columns, GravityMode::cascade,
+                          PieceRandomizer{seed}};
+    // the I completes row 12, whereupon the bar in the last column falls
+    // down and completes the 5 rows below
+    std::vector<std::pair<int, int>> locked_cells;
+    for (int row{15}; row < number_rows; ++row) {
+        for (int column{0}; column < number_columns - 1; ++column) {
+            locked_cells.emplace_back(row, column);
+        }
+    }
+    for (int column{1}; column < number_columns; ++column) {
+        locked_cells.emplace_back(12, column);
+    }
+    for (int row{5}; row < 10; ++row) {
+        locked_cells.emplace_back(row, number_columns - 1);
+    }
+    RestoreUprightIAboveCells(cascade_unit, locked_cells);
+
+    StepResult result{cascade_unit.Step(GameInput::hard_drop)};
+
+    // a single and a run of 5 rows, which scores a tetris and a single
+    EXPECT_EQ(6, result.number_cleared_lines);
+    EXPECT_EQ(40 + 1200 + 40, result.score_gained);
+    EXPECT_EQ(6, cascade_unit.GetNumberOfClearedLines());
+    EXPECT_EQ(1280, cascade_unit.GetScore());
+}
+
+TEST_F(GameCoreTest, InvalidStateIsRejected) {
+    unit.Step(GameInput::hard_drop);
+    std::vector<std::uint8_t> state;
+    unit.SaveState(state);
+    std::uint64_t hash{unit.ComputeStateHash()};
+    GameCore other_unit{number_rows, number_columns + 1};
+    GameCore cascade_unit{number_rows, number_columns, GravityMode::cascade};
+
+    EXPECT_FALSE(other_unit.RestoreState(state.data(), state.size()));
+    EXPECT_FALSE(cascade_unit.RestoreState(state.data(), state.size()));
+    for (std::size_t size :
+         {std::size_t{0}, std::size_t{4}, state.size() - 1}) {
+        EXPECT_FALSE(unit.RestoreState(state.data(), size)) << "size " << size;
+    }
+    std::vector<std::uint8_t> wrong_magic{state};
+    wrong_magic[1] = 'X';
+    EXPECT_FALSE(unit.RestoreState(wrong_magic.data(), wrong_magic.size()));
+    for (std::uint8_t version : {0, 2}) {
+        std::vector<std::uint8_t> wrong_version{state};
+        wrong_version[4] = version;
+        EXPECT_FALSE(
+            unit.RestoreState(wrong_version.data(), wrong_version.size()))
+            << "version " << static_cast<int>(version);
+    }
+    // the active piece is not on the grid anymore once its cells are freed
+    std::vector<std::uint8_t> freed_grid{state};
+    std::size_t cells_size{unit.GetGridLogic().GetPackedCellsSize()};
+    std::fill(freed_grid.end() - cells_size, freed_grid.end(), 0xFF);
+    std::fill(freed_grid.end() - cells_size,
+              freed_grid.end() - cells_size +
+                  unit.GetGridLogic().GetPackedBitsSize(),
+              0);
+    EXPECT_FALSE(unit.RestoreState(freed_grid.data(), freed_grid.size()));
+    // an occupied cell without a type apart from the active piece would be
+    // invisible but block the pieces
+    std::size_t bits_offset{state.size() - cells_size};
+    std::size_t types_offset{bits_offset +
+                             unit.GetGridLogic().GetPackedBitsSize()};
+    std::vector<std::uint8_t> stray_cell{state};
+    std::size_t stray_index{static_cast<std::size_t>(10 * number_columns)};
+    ASSERT_FALSE(unit.GetGridLogic().IsCellOccupied(10, 0));
+    stray_cell[bits_offset + stray_index / 8] |=
+        static_cast<std::uint8_t>(1U << (stray_index % 8));
+    EXPECT_FALSE(unit.RestoreState(stray_cell.data(), stray_cell.size()));
+    // the active piece must not overlap a locked cell, here of type I
+    std::vector<std::uint8_t> overlapping_piece{state};
+    const auto piece_cell{unit.GetActivePiece().GetCells()[0]};
+    std::size_t piece_index{static_cast<std::size_t>(
+        piece_cell.first * number_columns + piece_cell.second)};
+    std::uint8_t &type_byte{overlapping_piece[types_offset + piece_index / 2]};
+    type_byte = static_cast<std::uint8_t>(
+        type_byte & ~(0xFU << (4 * (piece_index % 2))));
+    EXPECT_FALSE(unit.RestoreState(overlapping_piece.data(),
+                                   overlapping_piece.size()));
+    EXPECT_EQ(hash, unit.ComputeStateHash());
+}
+
+TEST_F(GameCoreTest, RingPassedOnConstructionReceivesStartOfFirstGame) {
+    GameEventRing event_ring{16};
+    GameCore game_core{number_rows, number_columns, GravityMode::line,
+                       PieceRandomizer{seed}, PieceQueue::kDefaultLength,
+                       &event_ring};
+
+    GameEvent event;
+    ASSERT_TRUE(event_ring.TryPop(event));
+    EXPECT_EQ(GameEventType::new_game, event.type);
+    ASSERT_TRUE(event_ring.TryPop(event));
+    EXPECT_EQ(GameEventType::spawn, event.type);
+    EXPECT_EQ(game_core.GetActivePiece(), event.piece);
+    EXPECT_FALSE(event_ring.TryPop(event));
+}
+
+TEST_F(GameCoreTest, StepsEmitEventsToConnectedRing) {
+    GameEventRing event_ring{256};
+    unit.SetEventRing(&event_ring);
+    Piece spawned_piece{unit.GetActivePiece()};
+
+    unit.Step(GameInput::move_left);
+    unit.Step(GameInput::rotate);
+    unit.Step(GameInput::hard_drop);
+    unit.Step(GameInput::new_game);
+
+    std::vector<GameEvent> events(event_ring.GetCapacity());
+    events.resize(event_ring.PopBatch(events.data(), events.size()));
+    std::vector<GameEventType> expected_types{
+        GameEventType::move,     GameEventType::rotate, GameEventType::move,
+        GameEventType::lock,     GameEventType::spawn,  GameEventType::new_game,
+        GameEventType::spawn};
+    ASSERT_EQ(expected_types.size(), events.size());
+    for (std::size_t index{0}; index < events.size(); ++index) {
+        EXPECT_EQ(expected_types[index], events[index].type);
+    }
+    EXPECT_EQ(spawned_piece.Translated(0, -1), events[0].piece);
+    EXPECT_EQ(1u, events[0].tick);
+    EXPECT_EQ(3u, events[3].tick);
+    EXPECT_EQ(events[2].piece, events[3].piece);
+    EXPECT_EQ(number_rows - 1,
+              events[3].piece.row + events[3].piece.GetShapeInfo().bottom_row);
+    EXPECT_EQ(2, events[4].value);
+    EXPECT_EQ(unit.GetActivePiece(), events[6].piece);
+}
+
+TEST_F(GameCoreTest, LineClearEmitsRowsAndScore) {
+    GameEventRing event_ring{4096};
+    unit.SetEventRing(&event_ring);
+
+    GreedyInputPolicy policy;
+    policy.Reset(seed);
+    for (int step{0}; step < 2000 && unit.GetNumberOfClearedLines() < 4;
+         ++step) {
+        unit.Step(policy.GetNextInput(unit));
+    }
+    ASSERT_LT(0, unit.GetNumberOfClearedLines());
+
+    std::vector<GameEvent> events(event_ring.GetCapacity());
+    events.resize(event_ring.PopBatch(events.data(), events.size()));
+    int number_line_clears{0};
+    int score{0};
+    for (const GameEvent &event : events) {
+        if (event.type == GameEventType::line_clear) {
+            ++number_line_clears;
+            EXPECT_LE(0, event.value);
+            EXPECT_GT(number_rows, event.value);
+        } else if (event.type == GameEventType::score) {
+            score += event.value;
+        }
+    }
+    EXPECT_EQ(unit.GetNumberOfClearedLines(), number_line_clears);
+    EXPECT_EQ(unit.GetScore(), score);
+    EXPECT_EQ(0u, event_ring.GetNumberOfDroppedEvents());
+}
+
+TEST_F(GameCoreTest, LongPreviewQueueIsSpawnedInOrder) {
+    // tall enough to drop all pieces of the queue in the middle
+    int number_tall_rows{4 * PieceQueue::kMaxLength};
+    GameCore long_preview_unit{number_tall_rows, number_columns,
+                               GravityMode::line, PieceRandomizer{seed},
+                               PieceQueue::kMaxLength};
+    PieceQueue next_tetrominoes{long_preview_unit.GetNextTetrominoes()};
+    ASSERT_EQ(PieceQueue::kMaxLength, next_tetrominoes.size());
+
+    // the queue is dealt from the same sequence as the short one
+    EXPECT_EQ(unit.GetActivePiece(), long_preview_unit.GetActivePiece());
+    for (int index{0}; index < unit.GetNextTetrominoes().size(); ++index) {
+        EXPECT_EQ(unit.GetNextTetrominoes()[index], next_tetrominoes[index]);
+    }
+    for (int index{0}; index < next_tetrominoes.size(); ++index) {
+        long_preview_unit.Step(GameInput::hard_drop);
+        ASSERT_FALSE(long_preview_unit.IsGameOver());
+        EXPECT_EQ(next_tetrominoes[index],
+                  long_preview_unit.GetActivePiece().type);
+    }
+
+    std::vector<std::uint8_t> state;
+    long_preview_unit.SaveState(state);
+    GameCore restored_unit{number_tall_rows, number_columns};
+    ASSERT_TRUE(restored_unit.RestoreState(state.data(), state.size()));
+    EXPECT_EQ(long_preview_unit.GetNextTetrominoes(),
+              restored_unit.GetNextTetrominoes());
+}
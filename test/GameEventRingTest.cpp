@@ -0,0 +1,100 @@
+#include <thread>
+#include <vector>
+
+#include "../src/GameEvent.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+GameEvent MakeEvent(int value) {
+    GameEvent event;
+    event.type = GameEventType::score;
+    event.value = value;
+    return event;
+}
+
+}  // namespace
+
+TEST(GameEventRingTest, CapacityIsRoundedUpToPowerOfTwo) {
+    EXPECT_EQ(1u, GameEventRing{1}.GetCapacity());
+    EXPECT_EQ(8u, GameEventRing{5}.GetCapacity());
+    EXPECT_EQ(1024u, GameEventRing{1024}.GetCapacity());
+}
+
+TEST(GameEventRingTest, EventsArePoppedInOrder) {
+    GameEventRing unit{4};
+    GameEvent event;
+
+    EXPECT_FALSE(unit.TryPop(event));
+    for (int round{0}; round < 3; ++round) {
+        for (int value{0}; value < 3; ++value) {
+            EXPECT_TRUE(unit.TryPush(MakeEvent(10 * round + value)));
+        }
+        for (int value{0}; value < 3; ++value) {
+            ASSERT_TRUE(unit.TryPop(event));
+            EXPECT_EQ(10 * round + value, event.value);
+        }
+        EXPECT_FALSE(unit.TryPop(event));
+    }
+}
+
+TEST(GameEventRingTest, FullRingDropsEvents) {
+    GameEventRing unit{4};
+    for (int value{0}; value < 4; ++value) {
+        EXPECT_TRUE(unit.TryPush(MakeEvent(value)));
+    }
+
+    EXPECT_FALSE(unit.TryPush(MakeEvent(4)));
+    EXPECT_FALSE(unit.TryPush(MakeEvent(5)));
+    EXPECT_EQ(2u, unit.GetNumberOfDroppedEvents());
+
+    GameEvent event;
+    ASSERT_TRUE(unit.TryPop(event));
+    EXPECT_EQ(0, event.value);
+    EXPECT_TRUE(unit.TryPush(MakeEvent(6)));
+}
+
+TEST(GameEventRingTest, PopBatchTakesAvailableEvents) {
+    GameEventRing unit{8};
+    for (int value{0}; value < 5; ++value) {
+        unit.TryPush(MakeEvent(value));
+    }
+    std::vector<GameEvent> events(4);
+
+    ASSERT_EQ(4u, unit.PopBatch(events.data(), events.size()));
+    EXPECT_EQ(3, events[3].value);
+    ASSERT_EQ(1u, unit.PopBatch(events.data(), events.size()));
+    EXPECT_EQ(4, events[0].value);
+    EXPECT_EQ(0u, unit.PopBatch(events.data(), events.size()));
+}
+
+TEST(GameEventRingTest, ConsumerThreadReceivesAllEventsInOrder) {
+    constexpr int kNumberEvents{200000};
+    GameEventRing unit{64};
+
+    std::thread consumer{[&unit] {
+        std::vector<GameEvent> events(16);
+        int expected_value{0};
+        while (expected_value < kNumberEvents) {
+            std::size_t number_events{
+                unit.PopBatch(events.data(), events.size())};
+            for (std::size_t index{0}; index < number_events; ++index) {
+                ASSERT_EQ(expected_value, events[index].value);
+                ++expected_value;
+            }
+            if (number_events == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+    // retry instead of dropping to check that no event is lost or reordered
+    for (int value{0}; value < kNumberEvents; ++value) {
+        while (!unit.TryPush(MakeEvent(value))) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    GameEvent event;
+    EXPECT_FALSE(unit.TryPop(event));
+}
@@ -1,6 +1,17 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+
 #include "../src/GridLogic.h"
+#include "../src/VectorGridLogic.h"
 #include "gtest/gtest.h"
 
+// Every test is run against the bitboard based GridLogic as well as against
+// the VectorGridLogic reference implementation.
+template <typename GridLogicType>
 class GridLogicTest : public ::testing::Test {
    protected:
     GridLogicTest() : unit(number_rows, number_columns) {}
@@ -25,13 +36,16 @@ class GridLogicTest : public ::testing::Test {
 
     int number_rows{10};
     int number_columns{8};
-    GridLogic unit;
+    GridLogicType unit;
 };
 
-TEST_F(GridLogicTest, EmptyGridAtInstantiation) {
+using GridLogicImplementations = ::testing::Types<GridLogic, VectorGridLogic>;
+TYPED_TEST_SUITE(GridLogicTest, GridLogicImplementations);
+
+TYPED_TEST(GridLogicTest, EmptyGridAtInstantiation) {
     // check whether all grid cells are false
     bool is_occupancy_grid_empty{true};
-    auto occupancy_grid = unit.GetOccupancyGrid();
+    auto occupancy_grid = this->unit.GetOccupancyGrid();
     for (const auto& row : occupancy_grid) {
         for (const bool& is_cell_occupied : row) {
             if (is_cell_occupied) {
@@ -43,283 +57,336 @@ TEST_F(GridLogicTest, EmptyGridAtInstantiation) {
     EXPECT_TRUE(is_occupancy_grid_empty);
 }
 
-TEST_F(GridLogicTest, SuccessfullGridOccupancyRequestForTopLeftCorner) {
+TYPED_TEST(GridLogicTest, SuccessfullGridOccupancyRequestForTopLeftCorner) {
     // place a square-shape in the upper left corner
     TetrominoPositionType current_position{{0, 0}, {1, 0}, {1, 1}, {0, 1}};
     const TetrominoPositionType& target_position{current_position};
 
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest, SuccessfullGridOccupancyRequestForBottomRightCorner) {
+TYPED_TEST(GridLogicTest, SuccessfullGridOccupancyRequestForBottomRightCorner) {
     // place a square-shape in the bottom right corner
     TetrominoPositionType current_position{
-        {number_rows - 2, number_columns - 2},
-        {number_rows - 1, number_columns - 2},
-        {number_rows - 1, number_columns - 1},
-        {number_rows - 2, number_columns - 1}};
+        {this->number_rows - 2, this->number_columns - 2},
+        {this->number_rows - 1, this->number_columns - 2},
+        {this->number_rows - 1, this->number_columns - 1},
+        {this->number_rows - 2, this->number_columns - 1}};
     const TetrominoPositionType& target_position{current_position};
 
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest,
+TYPED_TEST(GridLogicTest,
        UnsuccessfullGridOccupancyRequestBecauseOfOutOfLeftBounce) {
     // place a square-shape in the upper left corner
     TetrominoPositionType current_position{{0, 0}, {1, 0}, {1, 1}, {0, 1}};
     TetrominoPositionType target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step to the left
     target_position = {{0, -1}, {1, -1}, {1, 0}, {0, 0}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_FALSE(actual_result);
 }
 
-TEST_F(GridLogicTest,
+TYPED_TEST(GridLogicTest,
        UnsuccessfullGridOccupancyRequestBecauseOfOutOfRightBounce) {
     // place a square-shape in the upper right corner
-    TetrominoPositionType current_position{{0, number_columns - 2},
-                                           {1, number_columns - 2},
-                                           {1, number_columns - 1},
-                                           {0, number_columns - 1}};
+    TetrominoPositionType current_position{{0, this->number_columns - 2},
+                                           {1, this->number_columns - 2},
+                                           {1, this->number_columns - 1},
+                                           {0, this->number_columns - 1}};
     TetrominoPositionType target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step to the right
-    target_position = {{0, number_columns - 1},
-                       {1, number_columns - 1},
-                       {1, number_columns},
-                       {0, number_columns}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    target_position = {{0, this->number_columns - 1},
+                       {1, this->number_columns - 1},
+                       {1, this->number_columns},
+                       {0, this->number_columns}};
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_FALSE(actual_result);
 }
 
-TEST_F(GridLogicTest,
+TYPED_TEST(GridLogicTest,
        UnsuccessfullGridOccupancyRequestBecauseOfOutOfBottomBounce) {
     // place a square-shape in the bottom left corner
-    TetrominoPositionType current_position{{number_rows - 2, 0},
-                                           {number_rows - 1, 0},
-                                           {number_rows - 1, 1},
-                                           {number_rows - 2, 1}};
+    TetrominoPositionType current_position{{this->number_rows - 2, 0},
+                                           {this->number_rows - 1, 0},
+                                           {this->number_rows - 1, 1},
+                                           {this->number_rows - 2, 1}};
     TetrominoPositionType target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step down
-    target_position = {{number_rows - 1, 0},
-                       {number_rows, 0},
-                       {number_rows, 1},
-                       {number_rows - 1, 1}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    target_position = {{this->number_rows - 1, 0},
+                       {this->number_rows, 0},
+                       {this->number_rows, 1},
+                       {this->number_rows - 1, 1}};
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_FALSE(actual_result);
 }
 
-TEST_F(GridLogicTest, UnsuccessfullGridOccupancyRequestBecauseAlreadyOccupied) {
+TYPED_TEST(GridLogicTest,
+           UnsuccessfullGridOccupancyRequestBecauseAlreadyOccupied) {
     // place a square-shape in the upper left corner
     TetrominoPositionType current_position{{0, 0}, {1, 0}, {1, 1}, {0, 1}};
     const TetrominoPositionType& target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // place a square-shape at the same place it has been before
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_FALSE(actual_result);
 }
 
-TEST_F(
+TYPED_TEST(
     GridLogicTest,
     SuccessfullGridOccupancyRequestWhenMovedRightLeftRightAndLeftAgainTwoStepsEachTime) {
     // place a square-shape in the upper left corner
     TetrominoPositionType current_position{{0, 0}, {1, 0}, {1, 1}, {0, 1}};
     TetrominoPositionType target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move 2 steps to the right
     current_position = target_position;
     target_position = {{0, 2}, {1, 2}, {1, 3}, {0, 3}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move 2 steps to the left
     current_position = target_position;
     target_position = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move 2 steps to the right
     current_position = target_position;
     target_position = {{0, 2}, {1, 2}, {1, 3}, {0, 3}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move 2 steps to the left again
     current_position = target_position;
     target_position = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest, SuccessfullGridOccupancyRequestWhenMovedRightOneStep) {
+TYPED_TEST(GridLogicTest,
+           SuccessfullGridOccupancyRequestWhenMovedRightOneStep) {
     // place a square-shape somewhere on the grid
     TetrominoPositionType current_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     TetrominoPositionType target_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step to the right
     target_position = {{3, 2 + 1}, {4, 2 + 1}, {4, 3 + 1}, {3, 3 + 1}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest, SuccessfullGridOccupancyRequestWhenMovedLeftOneStep) {
+TYPED_TEST(GridLogicTest, SuccessfullGridOccupancyRequestWhenMovedLeftOneStep) {
     // place a square-shape somewhere on the grid
     TetrominoPositionType current_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     TetrominoPositionType target_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step to the left
     target_position = {{3, 2 - 1}, {4, 2 - 1}, {4, 3 - 1}, {3, 3 - 1}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest, SuccessfullGridOccupancyRequestWhenMovedDownOneStep) {
+TYPED_TEST(GridLogicTest, SuccessfullGridOccupancyRequestWhenMovedDownOneStep) {
     // place a square-shape somewhere on the grid
     TetrominoPositionType current_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     TetrominoPositionType target_position{{3, 2}, {4, 2}, {4, 3}, {3, 3}};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // move the square-shape one step down
     target_position = {{3 + 1, 2}, {4 + 1, 2}, {4 + 1, 3}, {3 + 1, 3}};
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 }
 
-TEST_F(GridLogicTest, NoOccupiedRowsAtInstantiation) {
+TYPED_TEST(GridLogicTest, NoOccupiedRowsAtInstantiation) {
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_TRUE(vector_of_indexes_of_fully_occupied_rows.empty());
 }
 
-TEST_F(GridLogicTest, FirstBottomRowAlmostOccupied) {
+TYPED_TEST(GridLogicTest, FirstBottomRowAlmostOccupied) {
     // Occupy (n-2) cells in the bottom row
 
     // Occupy the left half of the row
-    TetrominoPositionType current_position{{number_rows - 1, 0},
-                                           {number_rows - 1, 1},
-                                           {number_rows - 1, 2},
-                                           {number_rows - 1, 3}};
+    TetrominoPositionType current_position{{this->number_rows - 1, 0},
+                                           {this->number_rows - 1, 1},
+                                           {this->number_rows - 1, 2},
+                                           {this->number_rows - 1, 3}};
     TetrominoPositionType target_position{current_position};
     bool actual_result =
-        unit.RequestSpaceOnGrid(current_position, target_position);
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     // Occupy the left half of the row
-    current_position = {{number_rows - 1, 4},
-                        {number_rows - 1, 5},
-                        {number_rows - 1, 6},
-                        {number_rows - 2, 6}};
+    current_position = {{this->number_rows - 1, 4},
+                        {this->number_rows - 1, 5},
+                        {this->number_rows - 1, 6},
+                        {this->number_rows - 2, 6}};
     target_position = current_position;
-    actual_result = unit.RequestSpaceOnGrid(current_position, target_position);
+    actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
     EXPECT_TRUE(actual_result);
 
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_TRUE(vector_of_indexes_of_fully_occupied_rows.empty());
 }
 
-TEST_F(GridLogicTest, FirstBottomRowOccupied) {
+TYPED_TEST(GridLogicTest, FirstBottomRowOccupied) {
     // Occupy the first bottom row
-    OccupyEntireRow(number_rows - 1);
+    this->OccupyEntireRow(this->number_rows - 1);
 
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_FALSE(vector_of_indexes_of_fully_occupied_rows.empty());
 
     EXPECT_EQ(1, vector_of_indexes_of_fully_occupied_rows.size());
-    EXPECT_EQ(number_rows - 1, vector_of_indexes_of_fully_occupied_rows.at(0));
+    EXPECT_EQ(this->number_rows - 1,
+              vector_of_indexes_of_fully_occupied_rows.at(0));
 }
 
-TEST_F(GridLogicTest, FirstAndSecondBottomRowOccupied) {
+TYPED_TEST(GridLogicTest, FirstAndSecondBottomRowOccupied) {
     // Occupy the first and the second bottom row
-    OccupyEntireRow(number_rows - 1);
-    OccupyEntireRow(number_rows - 2);
+    this->OccupyEntireRow(this->number_rows - 1);
+    this->OccupyEntireRow(this->number_rows - 2);
 
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_FALSE(vector_of_indexes_of_fully_occupied_rows.empty());
 
     EXPECT_EQ(2, vector_of_indexes_of_fully_occupied_rows.size());
-    EXPECT_EQ(number_rows - 1, vector_of_indexes_of_fully_occupied_rows.at(0));
-    EXPECT_EQ(number_rows - 2, vector_of_indexes_of_fully_occupied_rows.at(1));
+    EXPECT_EQ(this->number_rows - 1,
+              vector_of_indexes_of_fully_occupied_rows.at(0));
+    EXPECT_EQ(this->number_rows - 2,
+              vector_of_indexes_of_fully_occupied_rows.at(1));
 }
 
-TEST_F(GridLogicTest, FirstAndThirdBottomRowOccupied) {
+TYPED_TEST(GridLogicTest, FirstAndThirdBottomRowOccupied) {
     // Occupy the first and the third bottom row
-    OccupyEntireRow(number_rows - 1);
-    OccupyEntireRow(number_rows - 3);
+    this->OccupyEntireRow(this->number_rows - 1);
+    this->OccupyEntireRow(this->number_rows - 3);
 
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_FALSE(vector_of_indexes_of_fully_occupied_rows.empty());
 
     EXPECT_EQ(2, vector_of_indexes_of_fully_occupied_rows.size());
-    EXPECT_EQ(number_rows - 1, vector_of_indexes_of_fully_occupied_rows.at(0));
-    EXPECT_EQ(number_rows - 3, vector_of_indexes_of_fully_occupied_rows.at(1));
+    EXPECT_EQ(this->number_rows - 1,
+              vector_of_indexes_of_fully_occupied_rows.at(0));
+    EXPECT_EQ(this->number_rows - 3,
+              vector_of_indexes_of_fully_occupied_rows.at(1));
 }
 
-TEST_F(GridLogicTest, SecondAndFifthBottomRowOccupied) {
+TYPED_TEST(GridLogicTest, SecondAndFifthBottomRowOccupied) {
     // Occupy the second and the fifth bottom row
-    OccupyEntireRow(number_rows - 2);
-    OccupyEntireRow(number_rows - 5);
+    this->OccupyEntireRow(this->number_rows - 2);
+    this->OccupyEntireRow(this->number_rows - 5);
 
     auto vector_of_indexes_of_fully_occupied_rows =
-        unit.GetIndexesOfFullyOccupiedRows();
+        this->unit.GetIndexesOfFullyOccupiedRows();
     EXPECT_FALSE(vector_of_indexes_of_fully_occupied_rows.empty());
 
     EXPECT_EQ(2, vector_of_indexes_of_fully_occupied_rows.size());
-    EXPECT_EQ(number_rows - 2, vector_of_indexes_of_fully_occupied_rows.at(0));
-    EXPECT_EQ(number_rows - 5, vector_of_indexes_of_fully_occupied_rows.at(1));
+    EXPECT_EQ(this->number_rows - 2,
+              vector_of_indexes_of_fully_occupied_rows.at(0));
+    EXPECT_EQ(this->number_rows - 5,
+              vector_of_indexes_of_fully_occupied_rows.at(1));
 }
 
-TEST_F(GridLogicTest, FreeOneEntirelyOccupiedRow) {
+TYPED_TEST(GridLogicTest, RowNoLongerOccupiedAfterShapeMovedAway) {
+    this->OccupyEntireRow(this->number_rows - 1);
+    this->OccupyEntireRow(this->number_rows - 3);
+    EXPECT_EQ(
+        (std::vector<int>{this->number_rows - 1, this->number_rows - 3}),
+        this->unit.GetIndexesOfFullyOccupiedRows());
+
+    // move the right half of the bottom row one step up
+    TetrominoPositionType current_position{{this->number_rows - 1, 4},
+                                           {this->number_rows - 1, 5},
+                                           {this->number_rows - 1, 6},
+                                           {this->number_rows - 1, 7}};
+    TetrominoPositionType target_position{{this->number_rows - 2, 4},
+                                          {this->number_rows - 2, 5},
+                                          {this->number_rows - 2, 6},
+                                          {this->number_rows - 2, 7}};
+    bool actual_result =
+        this->unit.RequestSpaceOnGrid(current_position, target_position);
+    EXPECT_TRUE(actual_result);
+    EXPECT_EQ(std::vector<int>{this->number_rows - 3},
+              this->unit.GetIndexesOfFullyOccupiedRows());
+
+    // and move it back down again
+    actual_result =
+        this->unit.RequestSpaceOnGrid(target_position, current_position);
+    EXPECT_TRUE(actual_result);
+    EXPECT_EQ(
+        (std::vector<int>{this->number_rows - 1, this->number_rows - 3}),
+        this->unit.GetIndexesOfFullyOccupiedRows());
+}
+
+TYPED_TEST(GridLogicTest, FreeOneEntirelyOccupiedRow) {
     // Occupy some randomly selected cells
     TetrominoPositionType any_position{{1, 0}, {3, 4}, {5, 2}, {6, 7}};
-    bool actual_result = unit.RequestSpaceOnGrid(any_position, any_position);
+    bool actual_result =
+        this->unit.RequestSpaceOnGrid(any_position, any_position);
     EXPECT_TRUE(actual_result);
 
     // Occupy the first bottom row
-    OccupyEntireRow(number_rows - 1);
-    EXPECT_EQ(std::vector<int>{number_rows - 1},
-              unit.GetIndexesOfFullyOccupiedRows());
+    this->OccupyEntireRow(this->number_rows - 1);
+    EXPECT_EQ(std::vector<int>{this->number_rows - 1},
+              this->unit.GetIndexesOfFullyOccupiedRows());
 
     // construct expected grid
     std::vector<std::vector<bool>> expected_grid;
-    expected_grid.resize(number_rows);
+    expected_grid.resize(this->number_rows);
     for (auto& row : expected_grid) {
-        row.resize(number_columns);
+        row.resize(this->number_columns);
     }
-    for (int row_idx{0}; row_idx < number_rows; ++row_idx) {
-        for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+    for (int row_idx{0}; row_idx < this->number_rows; ++row_idx) {
+        for (int col_idx{0}; col_idx < this->number_columns; ++col_idx) {
             if (std::any_of(any_position.cbegin(), any_position.cend(),
                             [row_idx, col_idx](std::pair<int, int> i) {
                                 return i == std::make_pair(row_idx, col_idx);
@@ -329,39 +396,1001 @@ TEST_F(GridLogicTest, FreeOneEntirelyOccupiedRow) {
         }
     }
 
-    unit.FreeAllEntirelyOccupiedRows();
-    auto actual_indexes_of_occupied_rows = unit.GetIndexesOfFullyOccupiedRows();
-    std::vector<std::vector<bool>> actual_grid = unit.GetOccupancyGrid();
+    this->unit.FreeAllEntirelyOccupiedRows();
+    auto actual_indexes_of_occupied_rows =
+        this->unit.GetIndexesOfFullyOccupiedRows();
+    std::vector<std::vector<bool>> actual_grid = this->unit.GetOccupancyGrid();
 
     EXPECT_TRUE(actual_indexes_of_occupied_rows.empty());
     EXPECT_EQ(expected_grid, actual_grid);
 }
 
-TEST_F(GridLogicTest, FreeEntireGrid) {
+TYPED_TEST(GridLogicTest, FreeEntireGrid) {
     // Occupy some randomly selected cells
     TetrominoPositionType any_position{{1, 0}, {3, 4}, {5, 2}, {6, 7}};
-    bool actual_result = unit.RequestSpaceOnGrid(any_position, any_position);
+    bool actual_result =
+        this->unit.RequestSpaceOnGrid(any_position, any_position);
     EXPECT_TRUE(actual_result);
 
     // Occupy the first bottom row
-    OccupyEntireRow(number_rows - 1);
-    EXPECT_EQ(std::vector<int>{number_rows - 1},
-              unit.GetIndexesOfFullyOccupiedRows());
+    this->OccupyEntireRow(this->number_rows - 1);
+    EXPECT_EQ(std::vector<int>{this->number_rows - 1},
+              this->unit.GetIndexesOfFullyOccupiedRows());
 
     // construct expected grid
     std::vector<std::vector<bool>> expected_grid;
-    expected_grid.resize(number_rows);
+    expected_grid.resize(this->number_rows);
     for (auto& row : expected_grid) {
-        row.resize(number_columns);
+        row.resize(this->number_columns);
     }
-    for (int row_idx{0}; row_idx < number_rows; ++row_idx) {
-        for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+    for (int row_idx{0}; row_idx < this->number_rows; ++row_idx) {
+        for (int col_idx{0}; col_idx < this->number_columns; ++col_idx) {
             expected_grid.at(row_idx).at(col_idx) = false;
         }
     }
 
-    unit.FreeEntireGrid();
-    std::vector<std::vector<bool>> actual_grid = unit.GetOccupancyGrid();
+    this->unit.FreeEntireGrid();
+    std::vector<std::vector<bool>> actual_grid = this->unit.GetOccupancyGrid();
 
     EXPECT_EQ(expected_grid, actual_grid);
-}
\ No newline at end of file
+}
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// ------------- Tests for the row collapse ---------------- //
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+class GridLogicCollapseTest : public GridLogicTest<GridLogic> {};
+
+TEST_F(GridLogicCollapseTest, CollapseWithoutOccupiedRowsKeepsGrid) {
+    TetrominoPositionType any_position{{1, 0}, {3, 4}, {5, 2}, {6, 7}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(any_position, any_position));
+    auto expected_grid = unit.GetOccupancyGrid();
+
+    const std::vector<int>& row_remap = unit.CollapseEntirelyOccupiedRows();
+
+    std::vector<int> expected_row_remap(number_rows);
+    std::iota(expected_row_remap.begin(), expected_row_remap.end(), 0);
+    EXPECT_EQ(expected_row_remap, row_remap);
+    EXPECT_EQ(expected_grid, unit.GetOccupancyGrid());
+}
+
+TEST_F(GridLogicCollapseTest, CollapseFirstAndThirdBottomRow) {
+    // Occupy some cells above and between the rows being collapsed
+    TetrominoPositionType any_position{{1, 0}, {3, 4}, {8, 2}, {8, 7}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(any_position, any_position));
+    OccupyEntireRow(number_rows - 1);
+    OccupyEntireRow(number_rows - 3);
+
+    const std::vector<int>& row_remap = unit.CollapseEntirelyOccupiedRows();
+
+    std::vector<int> expected_row_remap{2, 3, 4, 5, 6, 7, 8, -1, 9, -1};
+    EXPECT_EQ(expected_row_remap, row_remap);
+    EXPECT_TRUE(unit.GetIndexesOfFullyOccupiedRows().empty());
+
+    std::vector<std::vector<bool>> expected_grid(
+        number_rows, std::vector<bool>(number_columns, false));
+    expected_grid.at(3).at(0) = true;
+    expected_grid.at(5).at(4) = true;
+    expected_grid.at(9).at(2) = true;
+    expected_grid.at(9).at(7) = true;
+    EXPECT_EQ(expected_grid, unit.GetOccupancyGrid());
+}
+
+TEST_F(GridLogicCollapseTest, RowsCanBeFilledAgainAfterCollapse) {
+    OccupyEntireRow(number_rows - 1);
+    OccupyEntireRow(number_rows - 2);
+    unit.CollapseEntirelyOccupiedRows();
+
+    OccupyEntireRow(number_rows - 1);
+    EXPECT_EQ(std::vector<int>{number_rows - 1},
+              unit.GetIndexesOfFullyOccupiedRows());
+}
+
+TEST_F(GridLogicCollapseTest, LockedCellTypesMoveDownWithTheirRows) {
+    TetrominoPositionType locked_position{{6, 1}, {7, 0}, {7, 1}, {7, 2}};
+    TetrominoPositionType active_position{{0, 3}, {0, 4}, {0, 5}, {0, 6}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(locked_position, locked_position));
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(active_position, active_position));
+    unit.LockCells(locked_position, TetrominoType::T);
+    OccupyEntireRow(number_rows - 1);
+    unit.LockCells({{number_rows - 1, 0}}, TetrominoType::I);
+
+    unit.CollapseEntirelyOccupiedRows();
+
+    std::vector<std::tuple<int, int, TetrominoType>> locked_cells;
+    unit.ForEachLockedCell([&](int row_idx, int col_idx, TetrominoType type) {
+        locked_cells.emplace_back(row_idx, col_idx, type);
+    });
+    std::vector<std::tuple<int, int, TetrominoType>> expected_locked_cells{
+        {7, 1, TetrominoType::T},
+        {8, 0, TetrominoType::T},
+        {8, 1, TetrominoType::T},
+        {8, 2, TetrominoType::T}};
+    EXPECT_EQ(expected_locked_cells, locked_cells);
+    EXPECT_EQ(TetrominoType::UNDEFINED, unit.GetCellType(0, 3));
+    EXPECT_EQ(TetrominoType::UNDEFINED, unit.GetCellType(9, 0));
+}
+
+TEST_F(GridLogicCollapseTest, LockedCellTypesAreForgottenOnReset) {
+    TetrominoPositionType locked_position{{8, 0}, {8, 1}, {9, 0}, {9, 1}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(locked_position, locked_position));
+    unit.LockCells(locked_position, TetrominoType::O);
+    EXPECT_EQ(TetrominoType::O, unit.GetCellType(9, 1));
+
+    unit.FreeEntireGrid();
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(locked_position, locked_position));
+
+    EXPECT_EQ(TetrominoType::UNDEFINED, unit.GetCellType(9, 1));
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// -------------- Tests for cascade gravity ---------------- //
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+class GridLogicCascadeTest : public GridLogicTest<GridLogic> {
+   protected:
+    // Occupies and locks the cells in chunks of at most four cells
+    void LockCells(const std::vector<std::pair<int, int>>& cells,
+                   TetrominoType type) {
+        for (std::size_t first{0}; first < cells.size(); first += 4) {
+            TetrominoPositionType position;
+            for (std::size_t index{first};
+                 index < std::min(first + 4, cells.size()); ++index) {
+                position.push_back(cells[index]);
+            }
+            EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+            unit.LockCells(position, type);
+        }
+    }
+
+    // Retrieves the grid as one string per row, '.' marks free cells and the
+    // first letter of the type marks locked cells
+    std::vector<std::string> GetLockedCells() {
+        std::vector<std::string> rows(number_rows,
+                                      std::string(number_columns, '.'));
+        unit.ForEachLockedCell([&](int row_idx, int col_idx,
+                                   TetrominoType type) {
+            rows.at(row_idx).at(col_idx) = "IJLOSTZ"[static_cast<int>(type)];
+        });
+        return rows;
+    }
+};
+
+TEST_F(GridLogicCascadeTest, StackedGroupsFallOntoEachOther) {
+    LockCells({{2, 3}, {3, 3}}, TetrominoType::I);
+    LockCells({{5, 3}, {5, 4}}, TetrominoType::O);
+
+    EXPECT_TRUE(unit.ApplyCascadeGravity());
+
+    std::vector<std::string> expected_cells{
+        "........", "........", "........", "........", "........",
+        "........", "........", "...I....", "...I....", "...OO..."};
+    EXPECT_EQ(expected_cells, GetLockedCells());
+    EXPECT_EQ(0, unit.GetNumberOfHoles());
+    EXPECT_FALSE(unit.ApplyCascadeGravity());
+}
+
+TEST_F(GridLogicCascadeTest, ArchFallsAgainAfterTheBlockBelowHasFallen) {
+    // The arch reaches lower than the single block under its top, so it is
+    // dropped first and lands on the block, which then falls to the floor
+    LockCells({{4, 1}, {4, 2}, {4, 3}, {4, 4}, {4, 5}, {5, 1}, {6, 1}, {7, 1},
+               {5, 5}, {6, 5}, {7, 5}},
+              TetrominoType::T);
+    LockCells({{6, 3}}, TetrominoType::I);
+
+    EXPECT_TRUE(unit.ApplyCascadeGravity());
+
+    std::vector<std::string> expected_cells{
+        "........", "........", "........", "........", "........",
+        "........", ".TTTTT..", ".T...T..", ".T...T..", ".T.I.T.."};
+    EXPECT_EQ(expected_cells, GetLockedCells());
+}
+
+TEST_F(GridLogicCascadeTest, InterlockedGroupsFallInTurns) {
+    // The hook reaches around the bar, so each of them lies below the other
+    // in some column and they fall in turns until both rest on the floor
+    LockCells({{2, 2}, {2, 3}, {2, 4}, {2, 5}, {2, 6}, {3, 6}, {4, 6}, {5, 6},
+               {6, 6}, {7, 6}, {7, 5}, {7, 4}, {7, 3}, {7, 2}},
+              TetrominoType::T);
+    LockCells({{4, 2}, {4, 3}, {4, 4}}, TetrominoType::O);
+
+    EXPECT_TRUE(unit.ApplyCascadeGravity());
+
+    std::vector<std::string> expected_cells{
+        "........", "........", "........", "........", "..TTTTT.",
+        "......T.", "......T.", "......T.", "..OOO.T.", "..TTTTT."};
+    EXPECT_EQ(expected_cells, GetLockedCells());
+    EXPECT_FALSE(unit.ApplyCascadeGravity());
+}
+
+TEST_F(GridLogicCascadeTest, FallingGroupFillsRow) {
+    LockCells({{9, 1}, {9, 2}, {9, 3}, {9, 4}, {9, 5}, {9, 6}, {9, 7}},
+              TetrominoType::L);
+    LockCells({{3, 0}}, TetrominoType::Z);
+    EXPECT_TRUE(unit.GetIndexesOfFullyOccupiedRows().empty());
+
+    unit.ApplyCascadeGravity();
+
+    EXPECT_EQ(std::vector<int>{number_rows - 1},
+              unit.GetIndexesOfFullyOccupiedRows());
+    EXPECT_EQ(TetrominoType::Z, unit.GetCellType(9, 0));
+    EXPECT_EQ(TetrominoType::UNDEFINED, unit.GetCellType(3, 0));
+}
+
+TEST_F(GridLogicCascadeTest, GroupsFallAfterClearingARow) {
+    // Clearing the bottom row splits the blocks above into two groups, one
+    // of them resting on the block in the second row from the bottom
+    LockCells({{9, 0}, {9, 1}, {9, 2}, {9, 3}, {9, 4}, {9, 5}, {9, 6}, {9, 7}},
+              TetrominoType::I);
+    LockCells({{8, 0}, {7, 0}, {7, 1}}, TetrominoType::J);
+    LockCells({{8, 6}}, TetrominoType::S);
+
+    unit.FreeAllEntirelyOccupiedRows();
+    unit.ApplyCascadeGravity();
+
+    std::vector<std::string> expected_cells{
+        "........", "........", "........", "........", "........",
+        "........", "........", "........", "JJ......", "J.....S."};
+    EXPECT_EQ(expected_cells, GetLockedCells());
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// ------ Tests for placing, translating and rotating ------ //
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+class GridLogicTryMoveTest : public GridLogicTest<GridLogic> {
+   protected:
+    // Retrieves the occupied cells of the grid
+    TetrominoPositionType GetOccupiedCells() {
+        TetrominoPositionType occupied_cells;
+        unit.ForEachOccupiedCell([&](int row_idx, int col_idx) {
+            occupied_cells.push_back({row_idx, col_idx});
+        });
+        return occupied_cells;
+    }
+};
+
+TEST_F(GridLogicTryMoveTest, PlaceTetromino) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::T, Orientation::north, 3, 2));
+    EXPECT_EQ((TetrominoPositionType{{3, 3}, {4, 2}, {4, 3}, {4, 4}}),
+              GetOccupiedCells());
+}
+
+TEST_F(GridLogicTryMoveTest, PlaceTetrominoRejectedBecauseOfStack) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::O, Orientation::north, 0, 0));
+    EXPECT_EQ(MoveResult::stack,
+              unit.TryPlace(TetrominoType::O, Orientation::north, 1, 1));
+}
+
+TEST_F(GridLogicTryMoveTest, PlaceTetrominoRejectedBecauseOfBounds) {
+    EXPECT_EQ(MoveResult::wall,
+              unit.TryPlace(TetrominoType::I, Orientation::north, 0, -1));
+    EXPECT_EQ(MoveResult::wall, unit.TryPlace(TetrominoType::I,
+                                              Orientation::north, 0,
+                                              number_columns - 3));
+    EXPECT_EQ(MoveResult::wall,
+              unit.TryPlace(TetrominoType::I, Orientation::north, -3, 0));
+    EXPECT_EQ(MoveResult::floor, unit.TryPlace(TetrominoType::I,
+                                               Orientation::north,
+                                               number_rows - 2, 0));
+    EXPECT_TRUE(GetOccupiedCells().empty());
+}
+
+TEST_F(GridLogicTryMoveTest, TranslateTetromino) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north, 0, 0));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryTranslate(TetrominoType::J, Orientation::north, 0, 0,
+                                1, 0));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryTranslate(TetrominoType::J, Orientation::north, 1, 0,
+                                0, 1));
+    EXPECT_EQ((TetrominoPositionType{{1, 1}, {2, 1}, {2, 2}, {2, 3}}),
+              GetOccupiedCells());
+}
+
+TEST_F(GridLogicTryMoveTest, TranslateTetrominoRejectedBecauseOfWall) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north, 0, 0));
+    EXPECT_EQ(MoveResult::wall,
+              unit.TryTranslate(TetrominoType::J, Orientation::north, 0, 0,
+                                0, -1));
+    EXPECT_EQ((TetrominoPositionType{{0, 0}, {1, 0}, {1, 1}, {1, 2}}),
+              GetOccupiedCells());
+}
+
+TEST_F(GridLogicTryMoveTest, TranslateTetrominoRejectedBecauseOfFloor) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north,
+                            number_rows - 2, 0));
+    EXPECT_EQ(MoveResult::floor,
+              unit.TryTranslate(TetrominoType::J, Orientation::north,
+                                number_rows - 2, 0, 1, 0));
+}
+
+TEST_F(GridLogicTryMoveTest, TranslateTetrominoRejectedBecauseOfStack) {
+    OccupyEntireRow(number_rows - 1);
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north,
+                            number_rows - 3, 0));
+    EXPECT_EQ(MoveResult::stack,
+              unit.TryTranslate(TetrominoType::J, Orientation::north,
+                                number_rows - 3, 0, 1, 0));
+}
+
+TEST_F(GridLogicTryMoveTest, RotateTetromino) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::north, 0, 0));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryRotate(TetrominoType::I, Orientation::north, 0, 0));
+    EXPECT_EQ((TetrominoPositionType{{0, 2}, {1, 2}, {2, 2}, {3, 2}}),
+              GetOccupiedCells());
+}
+
+TEST_F(GridLogicTryMoveTest, RotateTetrominoRejectedBecauseOfWall) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east, 0, -2));
+    EXPECT_EQ(MoveResult::wall,
+              unit.TryRotate(TetrominoType::I, Orientation::east, 0, -2));
+    EXPECT_EQ((TetrominoPositionType{{0, 0}, {1, 0}, {2, 0}, {3, 0}}),
+              GetOccupiedCells());
+}
+
+TEST_F(GridLogicTryMoveTest, MovePiece) {
+    Piece piece{MakePiece(TetrominoType::T, Orientation::north, 0, 0)};
+    EXPECT_EQ(MoveResult::success, unit.TryPlace(piece));
+    EXPECT_EQ(MoveResult::success, unit.TryTranslate(piece, 1, 2));
+    EXPECT_EQ(MakePiece(TetrominoType::T, Orientation::north, 1, 2), piece);
+    EXPECT_EQ(MoveResult::success, unit.TryRotate(piece));
+    EXPECT_EQ(MakePiece(TetrominoType::T, Orientation::east, 1, 2), piece);
+
+    TetrominoPositionType occupied_cells{GetOccupiedCells()};
+    TetrominoPositionType piece_cells{piece.GetCells()};
+    EXPECT_TRUE(std::is_permutation(occupied_cells.begin(),
+                                    occupied_cells.end(), piece_cells.begin(),
+                                    piece_cells.end()));
+    EXPECT_EQ(number_rows - 4, unit.GetDropDistance(piece));
+}
+
+TEST_F(GridLogicTryMoveTest, RejectedPieceMoveKeepsThePiece) {
+    Piece piece{MakePiece(TetrominoType::I, Orientation::east, 0, -2)};
+    EXPECT_EQ(MoveResult::success, unit.TryPlace(piece));
+    EXPECT_EQ(MoveResult::wall, unit.TryTranslate(piece, 0, -1));
+    EXPECT_EQ(MoveResult::wall, unit.TryRotate(piece));
+    EXPECT_EQ(MakePiece(TetrominoType::I, Orientation::east, 0, -2), piece);
+}
+
+TEST_F(GridLogicTryMoveTest, FullyOccupiedRowsAreTracked) {
+    for (int column{0}; column < number_columns; column += 2) {
+        EXPECT_EQ(MoveResult::success,
+                  unit.TryPlace(TetrominoType::O, Orientation::north,
+                                number_rows - 2, column));
+    }
+    EXPECT_EQ((std::vector<int>{number_rows - 1, number_rows - 2}),
+              unit.GetIndexesOfFullyOccupiedRows());
+
+    EXPECT_EQ(MoveResult::success,
+              unit.TryTranslate(TetrominoType::O, Orientation::north,
+                                number_rows - 2, 0, -1, 0));
+    EXPECT_EQ(std::vector<int>{number_rows - 2},
+              unit.GetIndexesOfFullyOccupiedRows());
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// ------------ Tests for the read-only views -------------- //
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Tests every position of every tetromino in and around the grid with
+// TestPlacements() and compares the results with TryPlace() on a copy of the
+// grid
+void ExpectPlacementsMatchTryPlace(const GridLogic& grid_logic) {
+    std::vector<PlacementCandidate> candidates;
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        for (int orientation_idx{0}; orientation_idx < kNumberOrientations;
+             ++orientation_idx) {
+            for (int row_idx{-4}; row_idx <= grid_logic.GetNumberOfRows();
+                 ++row_idx) {
+                for (int col_idx{-5};
+                     col_idx <= grid_logic.GetNumberOfColumns(); ++col_idx) {
+                    candidates.push_back(
+                        {static_cast<TetrominoType>(type_idx),
+                         static_cast<Orientation>(orientation_idx), row_idx,
+                         col_idx});
+                }
+            }
+        }
+    }
+
+    std::vector<std::uint64_t> result_bitmap(
+        GridLogic::GetPlacementBitmapSize(candidates.size()));
+    auto grid_before_test{grid_logic.GetOccupancyGrid()};
+    EXPECT_TRUE(grid_logic.TestPlacements(candidates.data(),
+                                          candidates.size(),
+                                          result_bitmap.data(),
+                                          result_bitmap.size()));
+    EXPECT_EQ(grid_before_test, grid_logic.GetOccupancyGrid());
+
+    for (std::size_t idx{0}; idx < candidates.size(); ++idx) {
+        const PlacementCandidate& candidate{candidates[idx]};
+        GridLogic copy{grid_logic};
+        bool expected_result{copy.TryPlace(candidate.type,
+                                           candidate.orientation,
+                                           candidate.row, candidate.column) ==
+                             MoveResult::success};
+        bool actual_result{((result_bitmap[idx / 64] >> (idx % 64)) & 1U) !=
+                           0};
+        EXPECT_EQ(expected_result, actual_result)
+            << "type " << static_cast<int>(candidate.type) << " orientation "
+            << static_cast<int>(candidate.orientation) << " row "
+            << candidate.row << " column " << candidate.column;
+    }
+}
+
+TEST_F(GridLogicTryMoveTest, TestPlacementsOnEmptyGrid) {
+    ExpectPlacementsMatchTryPlace(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, TestPlacementsOnOccupiedGrid) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::T, Orientation::north, 3, 2));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east, 5, -2));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::S, Orientation::west, 5, 5));
+    OccupyEntireRow(number_rows - 1);
+    ExpectPlacementsMatchTryPlace(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, TestPlacementsRejectsTooSmallBitmap) {
+    std::vector<PlacementCandidate> candidates(
+        65, {TetrominoType::O, Orientation::north, 0, 0});
+    std::vector<std::uint64_t> result_bitmap(1);
+    EXPECT_EQ(2, GridLogic::GetPlacementBitmapSize(candidates.size()));
+    EXPECT_FALSE(unit.TestPlacements(candidates.data(), candidates.size(),
+                                     result_bitmap.data(),
+                                     result_bitmap.size()));
+}
+
+// Computes heights, holes and well depths of all columns from the occupancy
+// grid and compares them with the values maintained by the grid
+void ExpectColumnPropertiesMatchGrid(const GridLogic& grid_logic) {
+    auto occupancy_grid{grid_logic.GetOccupancyGrid()};
+    int number_rows{grid_logic.GetNumberOfRows()};
+    int number_columns{grid_logic.GetNumberOfColumns()};
+    std::vector<int> expected_heights(number_columns, 0);
+    int expected_number_holes{0};
+    for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+        int expected_holes_in_column{0};
+        for (int row_idx{0}; row_idx < number_rows; ++row_idx) {
+            if (occupancy_grid[row_idx][col_idx]) {
+                if (expected_heights[col_idx] == 0) {
+                    expected_heights[col_idx] = number_rows - row_idx;
+                }
+            } else if (expected_heights[col_idx] != 0) {
+                ++expected_holes_in_column;
+            }
+        }
+        EXPECT_EQ(expected_holes_in_column,
+                  grid_logic.GetNumberOfHolesInColumn(col_idx));
+        expected_number_holes += expected_holes_in_column;
+    }
+    EXPECT_EQ(expected_heights, grid_logic.GetColumnHeights());
+    EXPECT_EQ(expected_number_holes, grid_logic.GetNumberOfHoles());
+
+    for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+        int left_height{col_idx > 0 ? expected_heights[col_idx - 1]
+                                    : number_rows};
+        int right_height{col_idx + 1 < number_columns
+                             ? expected_heights[col_idx + 1]
+                             : number_rows};
+        int expected_depth{std::min(left_height, right_height) -
+                           expected_heights[col_idx]};
+        EXPECT_EQ(std::max(0, expected_depth),
+                  grid_logic.GetWellDepth(col_idx))
+            << "column " << col_idx;
+    }
+}
+
+TEST_F(GridLogicTryMoveTest, ColumnPropertiesOfEmptyGrid) {
+    for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+        EXPECT_EQ(0, unit.GetColumnHeight(col_idx));
+        EXPECT_EQ(0, unit.GetWellDepth(col_idx));
+    }
+    EXPECT_EQ(0, unit.GetNumberOfHoles());
+}
+
+TEST_F(GridLogicTryMoveTest, ColumnPropertiesFollowMovingTetromino) {
+    // T-shape pointing downwards lying on the floor covers two holes
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::T, Orientation::south, 0, 2));
+    for (int step{0}; step < number_rows - 3; ++step) {
+        EXPECT_EQ(MoveResult::success,
+                  unit.TryTranslate(TetrominoType::T, Orientation::south, step,
+                                    2, 1, 0));
+        ExpectColumnPropertiesMatchGrid(unit);
+    }
+    EXPECT_EQ(2, unit.GetNumberOfHoles());
+    EXPECT_EQ(1, unit.GetNumberOfHolesInColumn(2));
+    EXPECT_EQ(2, unit.GetColumnHeight(2));
+    EXPECT_EQ(0, unit.GetColumnHeight(5));
+
+    // a vertical I-shape next to it forms a well in between
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east,
+                            number_rows - 4, 4));
+    EXPECT_EQ(2, unit.GetWellDepth(5));
+    ExpectColumnPropertiesMatchGrid(unit);
+
+    EXPECT_EQ(MoveResult::success,
+              unit.TryRotate(TetrominoType::T, Orientation::south,
+                             number_rows - 3, 2));
+    ExpectColumnPropertiesMatchGrid(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, ColumnPropertiesAfterRowsAreRemoved) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east,
+                            number_rows - 5, 3));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::O, Orientation::north,
+                            number_rows - 5, 0));
+    OccupyEntireRow(number_rows - 1);
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(5, unit.GetColumnHeight(5));
+
+    unit.CollapseEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(4, unit.GetColumnHeight(5));
+
+    OccupyEntireRow(number_rows - 6);
+    unit.FreeAllEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+
+    unit.FreeEntireGrid();
+    ExpectColumnPropertiesMatchGrid(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, ColumnPropertiesAfterCascade) {
+    // a bar hanging over a single block, which both fall once the full row
+    // below them has been freed
+    TetrominoPositionType bar{{2, 1}, {2, 2}, {2, 3}, {3, 1}};
+    TetrominoPositionType blocks{{4, 3}, {8, 6}, {8, 7}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(bar, bar));
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(blocks, blocks));
+    OccupyEntireRow(number_rows - 1);
+    unit.FreeAllEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+
+    EXPECT_TRUE(unit.ApplyCascadeGravity());
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(2, unit.GetColumnHeight(1));
+    EXPECT_EQ(1, unit.GetNumberOfHoles());
+}
+
+// Drops every tetromino in every orientation and column from the top of the
+// grid step by step and compares the number of steps with GetDropDistance()
+void ExpectDropDistancesMatchStepwiseDrop(const GridLogic& grid_logic) {
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        auto type{static_cast<TetrominoType>(type_idx)};
+        for (int orientation_idx{0}; orientation_idx < kNumberOrientations;
+             ++orientation_idx) {
+            auto orientation{static_cast<Orientation>(orientation_idx)};
+            const SquareOffsetsType& offsets{
+                GetSquareOffsets(type, orientation)};
+            int row_idx{-std::min_element(offsets.begin(), offsets.end())
+                             ->first};
+            for (int col_idx{-3}; col_idx < grid_logic.GetNumberOfColumns();
+                 ++col_idx) {
+                GridLogic copy{grid_logic};
+                if (copy.TryPlace(type, orientation, row_idx, col_idx) !=
+                    MoveResult::success) {
+                    continue;
+                }
+                TetrominoPositionType position;
+                for (const auto& offset : offsets) {
+                    position.push_back(
+                        {row_idx + offset.first, col_idx + offset.second});
+                }
+                int actual_distance{grid_logic.GetDropDistance(
+                    type, orientation, row_idx, col_idx)};
+                EXPECT_EQ(actual_distance, copy.GetDropDistance(position));
+
+                int expected_distance{0};
+                while (copy.TryTranslate(type, orientation,
+                                         row_idx + expected_distance, col_idx,
+                                         1, 0) == MoveResult::success) {
+                    ++expected_distance;
+                }
+                EXPECT_EQ(expected_distance, actual_distance)
+                    << "type " << type_idx << " orientation "
+                    << orientation_idx << " column " << col_idx;
+            }
+        }
+    }
+}
+
+TEST_F(GridLogicTryMoveTest, DropDistanceOnEmptyGrid) {
+    EXPECT_EQ(number_rows - 2,
+              unit.GetDropDistance(TetrominoType::O, Orientation::north, 0, 3));
+    ExpectDropDistancesMatchStepwiseDrop(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, DropDistanceOnStack) {
+    // an overhang: the drop is limited by the cell at row 5 in column 2 even
+    // though column 3 is empty down to the floor
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north, 4, 0));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east, 6, 4));
+    EXPECT_EQ(1, unit.GetDropDistance(TetrominoType::O, Orientation::north, 2,
+                                      2));
+    ExpectDropDistancesMatchStepwiseDrop(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, SaveAndRestoreState) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::J, Orientation::north, 4, 0));
+    OccupyEntireRow(number_rows - 1);
+    BoardState<10, 8> state;
+    EXPECT_TRUE(unit.SaveState(state));
+    auto saved_grid{unit.GetOccupancyGrid()};
+
+    // branch off and change the grid in several ways
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::east, 4, 4));
+    unit.CollapseEntirelyOccupiedRows();
+    EXPECT_NE(saved_grid, unit.GetOccupancyGrid());
+
+    EXPECT_TRUE(unit.RestoreState(state));
+    EXPECT_EQ(saved_grid, unit.GetOccupancyGrid());
+    EXPECT_EQ(std::vector<int>{number_rows - 1},
+              unit.GetIndexesOfFullyOccupiedRows());
+    ExpectColumnPropertiesMatchGrid(unit);
+}
+
+TEST_F(GridLogicTryMoveTest, StateIsAPlainCopyOfTheGrid) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::S, Orientation::north, 2, 3));
+    BoardState<10, 8> state{};
+    EXPECT_TRUE(unit.SaveState(state));
+    unit.ForEachCell([&](int row_idx, int col_idx, bool is_occupied) {
+        EXPECT_EQ(is_occupied, state.IsCellOccupied(row_idx, col_idx));
+    });
+
+    // snapshots can be copied bytewise and changed independently
+    BoardState<10, 8> copy;
+    std::memcpy(&copy, &state, sizeof(state));
+    EXPECT_EQ(state, copy);
+    copy.FreeCell(2, 4);
+    copy.OccupyCell(9, 7);
+    EXPECT_NE(state, copy);
+    EXPECT_FALSE(copy.IsCellOccupied(2, 4));
+    EXPECT_TRUE(copy.IsCellOccupied(9, 7));
+
+    EXPECT_TRUE(unit.RestoreState(copy));
+    EXPECT_FALSE(unit.IsCellOccupied(2, 4));
+    EXPECT_TRUE(unit.IsCellOccupied(9, 7));
+}
+
+TEST_F(GridLogicTryMoveTest, StateWithDifferentDimensionsIsRejected) {
+    StandardBoardState state{};
+    state.OccupyCell(0, 0);
+    EXPECT_FALSE(unit.SaveState(state));
+    EXPECT_FALSE(unit.RestoreState(state));
+    EXPECT_TRUE(state.IsCellOccupied(0, 0));
+    EXPECT_TRUE(GetOccupiedCells().empty());
+}
+
+class GridLogicViewTest : public ::testing::Test {
+   protected:
+    GridLogicViewTest() : unit(number_rows, number_columns) {
+        bool actual_result =
+            unit.RequestSpaceOnGrid(any_position, any_position);
+        EXPECT_TRUE(actual_result);
+    }
+
+    int number_rows{10};
+    int number_columns{8};
+    TetrominoPositionType any_position{{1, 0}, {3, 4}, {5, 2}, {9, 7}};
+    GridLogic unit;
+};
+
+TEST_F(GridLogicViewTest, RowViewReflectsOccupancyGrid) {
+    auto expected_grid = unit.GetOccupancyGrid();
+    for (int row_idx{0}; row_idx < number_rows; ++row_idx) {
+        GridRowView row_view = unit.GetRow(row_idx);
+        EXPECT_EQ(number_columns, row_view.GetNumberOfColumns());
+        for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+            EXPECT_EQ(expected_grid.at(row_idx).at(col_idx),
+                      row_view.IsCellOccupied(col_idx));
+            EXPECT_EQ(expected_grid.at(row_idx).at(col_idx),
+                      unit.IsCellOccupied(row_idx, col_idx));
+        }
+    }
+}
+
+TEST_F(GridLogicViewTest, RowViewFollowsChangesOfTheGrid) {
+    GridRowView row_view = unit.GetRow(3);
+    EXPECT_TRUE(row_view.IsCellOccupied(4));
+
+    TetrominoPositionType target_position{{1, 0}, {2, 4}, {5, 2}, {9, 7}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(any_position, target_position));
+    EXPECT_FALSE(row_view.IsCellOccupied(4));
+}
+
+TEST_F(GridLogicViewTest, VisitEveryCell) {
+    int number_visited_cells{0};
+    TetrominoPositionType visited_occupied_cells;
+    unit.ForEachCell([&](int row_idx, int col_idx, bool is_occupied) {
+        ++number_visited_cells;
+        if (is_occupied) {
+            visited_occupied_cells.push_back({row_idx, col_idx});
+        }
+    });
+    EXPECT_EQ(number_rows * number_columns, number_visited_cells);
+    EXPECT_EQ(any_position, visited_occupied_cells);
+}
+
+TEST_F(GridLogicViewTest, VisitOccupiedCellsOnly) {
+    TetrominoPositionType visited_cells;
+    unit.ForEachOccupiedCell([&](int row_idx, int col_idx) {
+        visited_cells.push_back({row_idx, col_idx});
+    });
+    EXPECT_EQ(any_position, visited_cells);
+}
+
+TEST_F(GridLogicViewTest, ExportPackedBits) {
+    std::vector<std::uint8_t> buffer(unit.GetPackedBitsSize(), 0xFF);
+    EXPECT_EQ(10, buffer.size());
+    EXPECT_TRUE(unit.ExportPackedBits(buffer.data(), buffer.size()));
+
+    std::vector<std::uint8_t> expected_buffer(buffer.size(), 0);
+    for (const auto& cell : any_position) {
+        int bit_index{cell.first * number_columns + cell.second};
+        expected_buffer.at(bit_index / 8) |= 1U << (bit_index % 8);
+    }
+    EXPECT_EQ(expected_buffer, buffer);
+}
+
+TEST_F(GridLogicViewTest, ExportPackedBitsRejectsTooSmallBuffer) {
+    std::vector<std::uint8_t> buffer(unit.GetPackedBitsSize() - 1);
+    EXPECT_FALSE(unit.ExportPackedBits(buffer.data(), buffer.size()));
+}
+
+// A board which is wider than one bitmask word and much taller than the
+// standard board, so that rows span three words with a partially used last
+// word.
+class GridLogicWideTest : public ::testing::Test {
+   protected:
+    GridLogicWideTest() : unit(number_rows, number_columns) {}
+
+    void OccupyEntireRow(int row_idx) {
+        for (int col_idx{0}; col_idx < number_columns; ++col_idx) {
+            TetrominoPositionType position{{row_idx, col_idx}};
+            EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+        }
+    }
+
+    int number_rows{300};
+    int number_columns{130};
+    GridLogic unit;
+};
+
+TEST_F(GridLogicWideTest, EmptyGridAtInstantiation) {
+    EXPECT_EQ(3, unit.GetRow(0).GetNumberOfWords());
+    for (int row_idx{0}; row_idx < number_rows; ++row_idx) {
+        EXPECT_TRUE(unit.IsRowEmpty(row_idx));
+        EXPECT_FALSE(unit.IsRowFull(row_idx));
+    }
+    EXPECT_TRUE(unit.GetIndexesOfFullyOccupiedRows().empty());
+}
+
+TEST_F(GridLogicWideTest, FullyOccupiedRowsAreTracked) {
+    OccupyEntireRow(number_rows - 1);
+    OccupyEntireRow(100);
+    std::vector<int> expected_rows{number_rows - 1, 100};
+    EXPECT_EQ(expected_rows, unit.GetIndexesOfFullyOccupiedRows());
+    EXPECT_TRUE(unit.IsRowFull(100));
+    EXPECT_FALSE(unit.IsRowEmpty(100));
+
+    // freeing the very last column makes the row incomplete again
+    TetrominoPositionType current_position{{100, number_columns - 1}};
+    TetrominoPositionType target_position{{99, number_columns - 1}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(current_position, target_position));
+    EXPECT_FALSE(unit.IsRowFull(100));
+    expected_rows = {number_rows - 1};
+    EXPECT_EQ(expected_rows, unit.GetIndexesOfFullyOccupiedRows());
+}
+
+TEST_F(GridLogicWideTest, TetrominoStraddlesWordBoundary) {
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::I, Orientation::north, 10, 62));
+    for (int col_idx{62}; col_idx < 66; ++col_idx) {
+        EXPECT_TRUE(unit.IsCellOccupied(12, col_idx));
+    }
+
+    EXPECT_EQ(MoveResult::success,
+              unit.TryTranslate(TetrominoType::I, Orientation::north, 10, 62,
+                                0, 1));
+    EXPECT_FALSE(unit.IsCellOccupied(12, 62));
+    EXPECT_TRUE(unit.IsCellOccupied(12, 66));
+
+    // an O-shape right below the second word boundary blocks the drop
+    EXPECT_EQ(MoveResult::success,
+              unit.TryPlace(TetrominoType::O, Orientation::north, 13, 127));
+    EXPECT_EQ(MoveResult::stack,
+              unit.TryTranslate(TetrominoType::I, Orientation::north, 10, 63,
+                                1, 63));
+    EXPECT_EQ(MoveResult::wall,
+              unit.TryTranslate(TetrominoType::I, Orientation::north, 10, 63,
+                                0, 64));
+    EXPECT_EQ(MoveResult::success,
+              unit.TryTranslate(TetrominoType::I, Orientation::north, 10, 63,
+                                0, 63));
+    EXPECT_TRUE(unit.IsCellOccupied(12, 129));
+}
+
+TEST_F(GridLogicWideTest, CollapseWideRows) {
+    OccupyEntireRow(number_rows - 1);
+    TetrominoPositionType position{{number_rows - 2, 64}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    OccupyEntireRow(number_rows - 3);
+
+    const std::vector<int>& row_remap{unit.CollapseEntirelyOccupiedRows()};
+    EXPECT_EQ(-1, row_remap.at(number_rows - 1));
+    EXPECT_EQ(number_rows - 1, row_remap.at(number_rows - 2));
+    EXPECT_EQ(-1, row_remap.at(number_rows - 3));
+    EXPECT_EQ(number_rows - 2, row_remap.at(number_rows - 4));
+    EXPECT_TRUE(unit.IsCellOccupied(number_rows - 1, 64));
+    EXPECT_TRUE(unit.IsRowEmpty(number_rows - 2));
+    EXPECT_TRUE(unit.GetIndexesOfFullyOccupiedRows().empty());
+}
+
+TEST_F(GridLogicWideTest, ImportExportedPackedBits) {
+    OccupyEntireRow(7);
+    TetrominoPositionType position{{8, 0}, {8, 63}, {8, 64}, {8, 129}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    std::vector<std::uint8_t> buffer(unit.GetPackedBitsSize());
+    EXPECT_TRUE(unit.ExportPackedBits(buffer.data(), buffer.size()));
+
+    GridLogic other_unit(number_rows, number_columns);
+    EXPECT_TRUE(other_unit.ImportPackedBits(buffer.data(), buffer.size()));
+    EXPECT_EQ(unit.GetOccupancyGrid(), other_unit.GetOccupancyGrid());
+    EXPECT_EQ(std::vector<int>{7},
+              other_unit.GetIndexesOfFullyOccupiedRows());
+
+    // the fill state of row 8 has been rebuilt, so filling the remaining
+    // cells makes it fully occupied
+    for (int col_idx{1}; col_idx < number_columns; ++col_idx) {
+        TetrominoPositionType cell{{8, col_idx}};
+        other_unit.RequestSpaceOnGrid(cell, cell);
+    }
+    std::vector<int> expected_rows{8, 7};
+    EXPECT_EQ(expected_rows, other_unit.GetIndexesOfFullyOccupiedRows());
+}
+
+TEST_F(GridLogicWideTest, ImportExportedPackedCells) {
+    TetrominoPositionType locked_position{{9, 0}, {9, 64}, {9, 129}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(locked_position, locked_position));
+    unit.LockCells(locked_position, TetrominoType::T);
+    TetrominoPositionType moving_position{{2, 5}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(moving_position, moving_position));
+    std::vector<std::uint8_t> buffer(unit.GetPackedCellsSize());
+    EXPECT_TRUE(unit.ExportPackedCells(buffer.data(), buffer.size()));
+
+    GridLogic other_unit(number_rows, number_columns);
+    EXPECT_TRUE(other_unit.ImportPackedCells(buffer.data(), buffer.size()));
+    EXPECT_EQ(unit.GetOccupancyGrid(), other_unit.GetOccupancyGrid());
+    EXPECT_EQ(TetrominoType::T, other_unit.GetCellType(9, 64));
+    EXPECT_EQ(TetrominoType::UNDEFINED, other_unit.GetCellType(2, 5));
+    EXPECT_EQ(unit.GetColumnHeights(), other_unit.GetColumnHeights());
+    EXPECT_EQ(unit.ComputeStateHash(), other_unit.ComputeStateHash());
+}
+
+TEST_F(GridLogicWideTest, ImportPackedCellsRejectsTypeOfFreeCell) {
+    TetrominoPositionType position{{9, 3}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    unit.LockCells(position, TetrominoType::O);
+    std::vector<std::uint8_t> buffer(unit.GetPackedCellsSize());
+    EXPECT_TRUE(unit.ExportPackedCells(buffer.data(), buffer.size()));
+    // free the cell but keep its type
+    std::size_t bit_index{static_cast<std::size_t>(9 * number_columns + 3)};
+    buffer[bit_index / 8] &= static_cast<std::uint8_t>(~(1U << bit_index % 8));
+
+    GridLogic other_unit(number_rows, number_columns);
+    EXPECT_FALSE(other_unit.ImportPackedCells(buffer.data(), buffer.size()));
+    EXPECT_FALSE(other_unit.ImportPackedCells(buffer.data(), 1));
+    EXPECT_TRUE(other_unit.IsRowEmpty(9));
+}
+
+TEST_F(GridLogicWideTest, AllRowScanImplementationsAgree) {
+    OccupyEntireRow(0);
+    TetrominoPositionType position{{1, 129}, {2, 0}, {3, 64}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+
+    RowScanImplementation default_implementation{GetRowScanImplementation()};
+    for (auto implementation :
+         {RowScanImplementation::scalar, RowScanImplementation::sse41,
+          RowScanImplementation::avx2}) {
+        if (!SetRowScanImplementation(implementation)) {
+            EXPECT_FALSE(IsRowScanImplementationSupported(implementation));
+            continue;
+        }
+        EXPECT_TRUE(unit.IsRowFull(0));
+        for (int row_idx{1}; row_idx < 4; ++row_idx) {
+            EXPECT_FALSE(unit.IsRowFull(row_idx));
+            EXPECT_FALSE(unit.IsRowEmpty(row_idx));
+        }
+        EXPECT_TRUE(unit.IsRowEmpty(4));
+    }
+    SetRowScanImplementation(default_implementation);
+}
+
+TEST_F(GridLogicWideTest, TestPlacementsAcrossWordBoundaries) {
+    GridLogic small_unit(6, number_columns);
+    TetrominoPositionType position1{{3, 0}, {3, 62}, {4, 64}};
+    TetrominoPositionType position2{{5, 65}, {2, 127}, {4, 129}};
+    EXPECT_TRUE(small_unit.RequestSpaceOnGrid(position1, position1));
+    EXPECT_TRUE(small_unit.RequestSpaceOnGrid(position2, position2));
+    ExpectPlacementsMatchTryPlace(small_unit);
+}
+
+TEST_F(GridLogicWideTest, ColumnPropertiesOfTallColumns) {
+    // cells in different words of the transposed columns
+    TetrominoPositionType position{{10, 64}, {70, 64}, {200, 64}, {299, 65}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(number_rows - 10, unit.GetColumnHeight(64));
+
+    // freeing the topmost cell makes the search continue in the next word
+    TetrominoPositionType target_position{
+        {9, 129}, {70, 64}, {200, 64}, {299, 65}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, target_position));
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(number_rows - 70, unit.GetColumnHeight(64));
+
+    OccupyEntireRow(150);
+    unit.CollapseEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+}
+
+TEST_F(GridLogicWideTest, ColumnPropertiesAfterRemovingRowsOfDifferentWords) {
+    // the removed rows lie around the word boundaries of the transposed
+    // columns, so the rows above them are carried across words
+    TetrominoPositionType position{{5, 0}, {61, 3}, {65, 64}, {126, 3}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    TetrominoPositionType lower_position{{190, 129}, {250, 1}, {299, 2}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(lower_position, lower_position));
+    for (int row_idx : {0, 62, 63, 64, 127, 191, 298}) {
+        OccupyEntireRow(row_idx);
+    }
+
+    unit.CollapseEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+    for (const auto &cell : TetrominoPositionType{
+             {11, 0}, {67, 3}, {68, 64}, {129, 3}}) {
+        EXPECT_TRUE(unit.IsCellOccupied(cell.first, cell.second));
+    }
+    EXPECT_EQ(number_rows - 68, unit.GetColumnHeight(64));
+    EXPECT_EQ(8, unit.GetDropDistance(TetrominoPositionType{{2, 0}}));
+    EXPECT_EQ(58, unit.GetDropDistance(TetrominoPositionType{{70, 3}}));
+
+    OccupyEntireRow(200);
+    OccupyEntireRow(66);
+    unit.FreeAllEntirelyOccupiedRows();
+    ExpectColumnPropertiesMatchGrid(unit);
+    EXPECT_EQ(233, unit.GetDropDistance(TetrominoPositionType{{66, 0}}));
+}
+
+TEST_F(GridLogicWideTest, SaveAndRestoreWideState) {
+    OccupyEntireRow(number_rows - 1);
+    TetrominoPositionType position{{3, 64}, {4, 129}, {200, 0}, {298, 0}};
+    EXPECT_TRUE(unit.RequestSpaceOnGrid(position, position));
+    auto state{std::make_unique<BoardState<300, 130>>()};
+    EXPECT_EQ(3, state->kNumberWordsPerRow);
+    EXPECT_TRUE(unit.SaveState(*state));
+
+    GridLogic other_unit(number_rows, number_columns);
+    EXPECT_TRUE(other_unit.RestoreState(*state));
+    EXPECT_EQ(unit.GetOccupancyGrid(), other_unit.GetOccupancyGrid());
+    EXPECT_EQ(std::vector<int>{number_rows - 1},
+              other_unit.GetIndexesOfFullyOccupiedRows());
+    ExpectColumnPropertiesMatchGrid(other_unit);
+}
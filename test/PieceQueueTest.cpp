@@ -0,0 +1,66 @@
+#include <vector>
+
+#include "../src/PieceQueue.h"
+#include "gtest/gtest.h"
+
+class PieceQueueTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(PieceQueueTest, FillTakesTypesFromRandomizer) {
+    PieceQueue unit{GetParam()};
+    PieceRandomizer randomizer{42, RandomizerPolicy::bag};
+    PieceRandomizer expected_randomizer{randomizer};
+
+    unit.Fill(randomizer);
+
+    ASSERT_EQ(GetParam(), unit.size());
+    for (int index{0}; index < unit.size(); ++index) {
+        EXPECT_EQ(expected_randomizer.Next(), unit[index]);
+    }
+    EXPECT_EQ(expected_randomizer.Next(), randomizer.Next());
+}
+
+TEST_P(PieceQueueTest, PopAndPushKeepsOrderAcrossRingEnd) {
+    PieceQueue unit{GetParam()};
+    PieceRandomizer randomizer{7};
+    unit.Fill(randomizer);
+    // the same sequence as the queue, which is popped in order
+    PieceRandomizer sequence{7};
+    std::vector<TetrominoType> pushed_types;
+
+    for (int round{0}; round < 40; ++round) {
+        TetrominoType pushed_type{randomizer.Next()};
+        EXPECT_EQ(sequence.Next(), unit.PopAndPush(pushed_type));
+        EXPECT_EQ(pushed_type, unit.back());
+    }
+    ASSERT_EQ(GetParam(), unit.size());
+    PieceRandomizer remaining{sequence};
+    for (int index{0}; index < unit.size(); ++index) {
+        EXPECT_EQ(remaining.Next(), unit[index]);
+    }
+    EXPECT_EQ(unit.front(), unit[0]);
+}
+
+TEST_P(PieceQueueTest, EqualQueuesMayStartAnywhereInRing) {
+    PieceQueue unit{GetParam()};
+    PieceRandomizer randomizer{3};
+    unit.Fill(randomizer);
+    for (int round{0}; round < 5; ++round) {
+        unit.PopAndPush(randomizer.Next());
+    }
+    std::vector<TetrominoType> types;
+    for (int index{0}; index < unit.size(); ++index) {
+        types.push_back(unit[index]);
+    }
+    PieceQueue other_unit;
+    other_unit.Assign(types.data(), static_cast<int>(types.size()));
+
+    EXPECT_EQ(unit, other_unit);
+    other_unit.PopAndPush(other_unit.front());
+    if (GetParam() > 1 && unit[0] != unit[1]) {
+        EXPECT_NE(unit, other_unit);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLengths, PieceQueueTest,
+                         ::testing::Range(PieceQueue::kMinLength,
+                                          PieceQueue::kMaxLength + 1));
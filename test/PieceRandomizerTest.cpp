@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "../src/PieceRandomizer.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr std::uint64_t kSeed{20200815};
+
+std::vector<TetrominoType> PickTypes(PieceRandomizer &randomizer,
+                                     std::size_t number_types) {
+    std::vector<TetrominoType> types;
+    for (std::size_t index{0}; index < number_types; ++index) {
+        types.push_back(randomizer.Next());
+    }
+    return types;
+}
+
+}  // namespace
+
+class PieceRandomizerTest
+    : public ::testing::TestWithParam<RandomizerPolicy> {};
+
+TEST_P(PieceRandomizerTest, SameSeedGeneratesSameSequence) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    PieceRandomizer other_unit{kSeed, GetParam()};
+    PieceRandomizer other_seed_unit{kSeed + 1, GetParam()};
+
+    std::vector<TetrominoType> types{PickTypes(unit, 100)};
+
+    EXPECT_EQ(types, PickTypes(other_unit, 100));
+    EXPECT_NE(types, PickTypes(other_seed_unit, 100));
+    EXPECT_EQ(kSeed, unit.GetSeed());
+    EXPECT_EQ(GetParam(), unit.GetPolicy());
+}
+
+TEST_P(PieceRandomizerTest, CopyContinuesTheSequence) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    PickTypes(unit, 10);
+
+    PieceRandomizer copy{unit};
+
+    EXPECT_EQ(PickTypes(copy, 100), PickTypes(unit, 100));
+}
+
+TEST_P(PieceRandomizerTest, ReadStateContinuesTheSequence) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    PickTypes(unit, 10);
+    std::vector<std::uint8_t> buffer;
+    ByteWriter writer{buffer};
+    unit.WriteState(writer);
+
+    PieceRandomizer other_unit{kSeed + 1};
+    ByteReader reader{buffer.data(), buffer.size()};
+    EXPECT_TRUE(other_unit.ReadState(reader));
+    EXPECT_TRUE(reader.IsAtEnd());
+    EXPECT_EQ(kSeed, other_unit.GetSeed());
+    EXPECT_EQ(GetParam(), other_unit.GetPolicy());
+    EXPECT_EQ(PickTypes(other_unit, 100), PickTypes(unit, 100));
+}
+
+TEST_P(PieceRandomizerTest, ReadStateRejectsInvalidState) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    std::vector<std::uint8_t> buffer;
+    ByteWriter writer{buffer};
+    unit.WriteState(writer);
+    PieceRandomizer other_unit{kSeed + 1};
+
+    ByteReader truncated_reader{buffer.data(), buffer.size() - 1};
+    EXPECT_FALSE(other_unit.ReadState(truncated_reader));
+    // the policy follows the seed and the generator state
+    buffer[16] = 7;
+    ByteReader reader{buffer.data(), buffer.size()};
+    EXPECT_FALSE(other_unit.ReadState(reader));
+    EXPECT_EQ(kSeed + 1, other_unit.GetSeed());
+}
+
+TEST_P(PieceRandomizerTest, GenerateMatchesSinglePicks) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    PieceRandomizer other_unit{kSeed, GetParam()};
+    std::vector<TetrominoType> types(1000, TetrominoType::UNDEFINED);
+
+    unit.Generate(types.data(), types.size());
+
+    EXPECT_EQ(PickTypes(other_unit, types.size()), types);
+    EXPECT_EQ(unit.Next(), other_unit.Next());
+}
+
+TEST_P(PieceRandomizerTest, AllTypesAreGeneratedEvenly) {
+    PieceRandomizer unit{kSeed, GetParam()};
+    std::array<int, kNumberTetrominoTypes> counts{};
+
+    for (TetrominoType type : PickTypes(unit, 7000)) {
+        ASSERT_NE(TetrominoType::UNDEFINED, type);
+        ++counts[static_cast<int>(type)];
+    }
+
+    for (int count : counts) {
+        EXPECT_NEAR(1000, count, 150);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllPolicies, PieceRandomizerTest,
+                         ::testing::Values(RandomizerPolicy::uniform,
+                                           RandomizerPolicy::bag,
+                                           RandomizerPolicy::history));
+
+TEST(PieceRandomizerBagTest, EveryBagHoldsAllTypesOnce) {
+    PieceRandomizer unit{kSeed, RandomizerPolicy::bag};
+
+    for (int bag{0}; bag < 100; ++bag) {
+        std::vector<TetrominoType> types{
+            PickTypes(unit, kNumberTetrominoTypes)};
+        std::sort(types.begin(), types.end());
+        EXPECT_EQ(types.end(), std::adjacent_find(types.begin(), types.end()));
+    }
+}
+
+TEST(PieceRandomizerHistoryTest, RecentTypesAreRepeatedRarely) {
+    // a uniform randomizer repeats one of the last four types in roughly
+    // every second pick
+    PieceRandomizer uniform_unit{kSeed, RandomizerPolicy::uniform};
+    PieceRandomizer unit{kSeed, RandomizerPolicy::history};
+    auto count_repetitions = [](const std::vector<TetrominoType> &types) {
+        int number_repetitions{0};
+        for (std::size_t index{PieceRandomizer::kHistoryLength};
+             index < types.size(); ++index) {
+            auto history_begin{types.begin() + index -
+                               PieceRandomizer::kHistoryLength};
+            auto history_end{types.begin() + index};
+            if (std::find(history_begin, history_end, types[index]) !=
+                history_end) {
+                ++number_repetitions;
+            }
+        }
+        return number_repetitions;
+    };
+
+    int number_uniform_repetitions{
+        count_repetitions(PickTypes(uniform_unit, 10000))};
+    int number_repetitions{count_repetitions(PickTypes(unit, 10000))};
+
+    EXPECT_LT(4000, number_uniform_repetitions);
+    EXPECT_GT(1000, number_repetitions);
+}
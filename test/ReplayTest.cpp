@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../src/InputPolicy.h"
+#include "../src/Replay.h"
+#include "gtest/gtest.h"
+
+class ReplayTest : public ::testing::Test {
+   protected:
+    ReplayTest() {
+        GameCore game_core{20, 10, GravityMode::line,
+                           PieceRandomizer{4321, RandomizerPolicy::bag}};
+        ReplayRecorder recorder{game_core};
+        GreedyInputPolicy policy;
+        policy.Reset(4321);
+        // every fourth step goes without input like a step of the gravity
+        // timer, which the replay only counts
+        for (int step{0}; step < 2000 && !game_core.IsGameOver(); ++step) {
+            GameInput input{step % 4 == 3 ? GameInput::none
+                                          : policy.GetNextInput(game_core)};
+            game_core.Step(input);
+            recorder.Record(input, game_core);
+        }
+        replay = recorder.GetReplay();
+        score = game_core.GetScore();
+    }
+    Replay replay;
+    int score{0};
+};
+
+TEST_F(ReplayTest, RecordsInputsOnly) {
+    EXPECT_LT(100u, replay.number_ticks);
+    EXPECT_LT(0u, replay.events.size());
+    EXPECT_GT(replay.number_ticks, replay.events.size());
+    for (const ReplayEvent &event : replay.events) {
+        EXPECT_NE(GameInput::none, event.input);
+        EXPECT_NE(3u, event.tick % 4);
+    }
+    EXPECT_EQ(4321u, replay.header.seed);
+    EXPECT_EQ(RandomizerPolicy::bag, replay.header.randomizer_policy);
+}
+
+TEST_F(ReplayTest, PlaybackIsIdentical) {
+    ReplayResult result{PlayReplay(replay)};
+
+    EXPECT_TRUE(result.is_identical);
+    EXPECT_EQ(replay.number_ticks, result.mismatch_detection_tick);
+    EXPECT_EQ(replay.number_ticks, result.number_ticks);
+    EXPECT_EQ(replay.final_state_hash, result.final_state_hash);
+    EXPECT_EQ(score, result.score);
+}
+
+TEST_F(ReplayTest, PlaybackStopsAtTheFirstDeviation) {
+    std::size_t event_index{replay.events.size() / 2};
+    for (; event_index < replay.events.size(); ++event_index) {
+        if (replay.events[event_index].input == GameInput::move_left) {
+            break;
+        }
+    }
+    ASSERT_LT(event_index, replay.events.size());
+    replay.events[event_index].input = GameInput::move_right;
+
+    ReplayResult result{PlayReplay(replay)};
+
+    EXPECT_FALSE(result.is_identical);
+    EXPECT_EQ(replay.events[event_index].tick, result.mismatch_detection_tick);
+    EXPECT_EQ(replay.events[event_index].tick + 1, result.number_ticks);
+}
+
+TEST_F(ReplayTest, RecordingOfRestoredGameIsIdentical) {
+    GameCore game_core{20, 10, GravityMode::line, PieceRandomizer{99}};
+    for (int step{0}; step < 30; ++step) {
+        game_core.Step(step % 3 == 0 ? GameInput::hard_drop
+                                     : GameInput::move_left);
+    }
+    std::vector<std::uint8_t> state;
+    game_core.SaveState(state);
+    GameCore restored_game_core{20, 10};
+    ASSERT_TRUE(restored_game_core.RestoreState(state.data(), state.size()));
+
+    ReplayRecorder recorder{restored_game_core};
+    for (int step{0}; step < 30; ++step) {
+        GameInput input{step % 2 == 0 ? GameInput::rotate
+                                      : GameInput::hard_drop};
+        restored_game_core.Step(input);
+        recorder.Record(input, restored_game_core);
+    }
+    ReplayResult result{PlayReplay(recorder.GetReplay())};
+
+    EXPECT_TRUE(result.is_identical);
+    EXPECT_EQ(60u, result.number_ticks);
+    EXPECT_EQ(restored_game_core.GetScore(), result.score);
+}
+
+TEST_F(ReplayTest, DifferentSeedIsDetected) {
+    // without an initial state, the game starts from the seed of the header
+    replay.initial_state.clear();
+    EXPECT_TRUE(PlayReplay(replay).is_identical);
+    ++replay.header.seed;
+
+    EXPECT_FALSE(PlayReplay(replay).is_identical);
+}
+
+TEST_F(ReplayTest, SerializedReplayRoundTrips) {
+    std::vector<std::uint8_t> data{SerializeReplay(replay)};
+    Replay deserialized_replay;
+
+    ASSERT_TRUE(
+        DeserializeReplay(data.data(), data.size(), deserialized_replay));
+    EXPECT_EQ(replay.header.seed, deserialized_replay.header.seed);
+    EXPECT_EQ(replay.header.randomizer_policy,
+              deserialized_replay.header.randomizer_policy);
+    EXPECT_EQ(replay.header.gravity_mode,
+              deserialized_replay.header.gravity_mode);
+    EXPECT_EQ(replay.header.number_grid_rows,
+              deserialized_replay.header.number_grid_rows);
+    EXPECT_EQ(replay.header.number_grid_columns,
+              deserialized_replay.header.number_grid_columns);
+    EXPECT_EQ(replay.number_ticks, deserialized_replay.number_ticks);
+    EXPECT_EQ(replay.final_state_hash, deserialized_replay.final_state_hash);
+    EXPECT_EQ(replay.initial_state, deserialized_replay.initial_state);
+    ASSERT_EQ(replay.events.size(), deserialized_replay.events.size());
+    for (std::size_t index{0}; index < replay.events.size(); ++index) {
+        EXPECT_EQ(replay.events[index].tick,
+                  deserialized_replay.events[index].tick);
+        EXPECT_EQ(replay.events[index].input,
+                  deserialized_replay.events[index].input);
+        EXPECT_EQ(replay.events[index].state_hash,
+                  deserialized_replay.events[index].state_hash);
+    }
+    EXPECT_TRUE(PlayReplay(deserialized_replay).is_identical);
+}
+
+TEST_F(ReplayTest, SerializedEventsTakeSixBytes) {
+    std::vector<std::uint8_t> data{SerializeReplay(replay)};
+
+    // header of 36 bytes, the initial state and the number of events with
+    // two varints for their sizes
+    EXPECT_GE(36 + 2 + replay.initial_state.size() + 2 +
+                  6 * replay.events.size(),
+              data.size());
+}
+
+TEST_F(ReplayTest, InvalidDataIsRejected) {
+    std::vector<std::uint8_t> data{SerializeReplay(replay)};
+    Replay deserialized_replay;
+
+    for (std::size_t size : {std::size_t{0}, std::size_t{10},
+                             std::size_t{36}, data.size() - 1}) {
+        EXPECT_FALSE(
+            DeserializeReplay(data.data(), size, deserialized_replay))
+            << "size " << size;
+    }
+
+    std::vector<std::uint8_t> wrong_magic{data};
+    wrong_magic[0] = 'X';
+    EXPECT_FALSE(DeserializeReplay(wrong_magic.data(), wrong_magic.size(),
+                                   deserialized_replay));
+
+    for (std::uint8_t version : {0, 2}) {
+        std::vector<std::uint8_t> wrong_version{data};
+        wrong_version[4] = version;
+        EXPECT_FALSE(DeserializeReplay(wrong_version.data(),
+                                       wrong_version.size(),
+                                       deserialized_replay))
+            << "version " << static_cast<int>(version);
+    }
+
+    // the number of rows at byte 8 and of columns at byte 10
+    std::vector<std::uint8_t> huge_grid{data};
+    std::fill_n(huge_grid.begin() + 8, 4, 0xFF);
+    EXPECT_FALSE(DeserializeReplay(huge_grid.data(), huge_grid.size(),
+                                   deserialized_replay));
+    std::vector<std::uint8_t> narrow_grid{data};
+    narrow_grid[10] = 3;
+    narrow_grid[11] = 0;
+    EXPECT_FALSE(DeserializeReplay(narrow_grid.data(), narrow_grid.size(),
+                                   deserialized_replay));
+
+    std::vector<std::uint8_t> trailing_byte{data};
+    trailing_byte.push_back(0);
+    EXPECT_FALSE(DeserializeReplay(trailing_byte.data(), trailing_byte.size(),
+                                   deserialized_replay));
+}
@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "../src/RowScan.h"
+#include "gtest/gtest.h"
+
+// Every test is run against all row scan implementations supported by the
+// CPU. Rows of 11 words exercise the vectorized loops as well as their
+// remainders.
+class RowScanTest
+    : public ::testing::TestWithParam<RowScanImplementation> {
+   protected:
+    void SetUp() override {
+        default_implementation = GetRowScanImplementation();
+        if (!SetRowScanImplementation(GetParam())) {
+            GTEST_SKIP() << "implementation not supported by the CPU";
+        }
+    }
+
+    void TearDown() override {
+        SetRowScanImplementation(default_implementation);
+    }
+
+    RowScanImplementation default_implementation{};
+    int number_words{11};
+    RowBitsType last_word_mask{(RowBitsType{1} << 5) - 1};
+    std::vector<RowBitsType> full_row =
+        std::vector<RowBitsType>(number_words, ~RowBitsType{0});
+    std::vector<RowBitsType> empty_row =
+        std::vector<RowBitsType>(number_words, 0);
+};
+
+INSTANTIATE_TEST_SUITE_P(AllImplementations, RowScanTest,
+                         ::testing::Values(RowScanImplementation::scalar,
+                                           RowScanImplementation::sse41,
+                                           RowScanImplementation::avx2));
+
+TEST_P(RowScanTest, ScalarIsAlwaysSupported) {
+    EXPECT_TRUE(
+        IsRowScanImplementationSupported(RowScanImplementation::scalar));
+}
+
+TEST_P(RowScanTest, FullRow) {
+    full_row.back() = last_word_mask;
+    EXPECT_TRUE(IsRowFull(full_row.data(), number_words, last_word_mask));
+    EXPECT_FALSE(IsRowEmpty(full_row.data(), number_words));
+}
+
+TEST_P(RowScanTest, RowWithOneFreeCellIsNotFull) {
+    full_row.back() = last_word_mask;
+    for (int word{0}; word < number_words; ++word) {
+        std::vector<RowBitsType> row{full_row};
+        row.at(word) &= ~(RowBitsType{1} << 3);
+        EXPECT_FALSE(IsRowFull(row.data(), number_words, last_word_mask));
+    }
+}
+
+TEST_P(RowScanTest, EmptyRow) {
+    EXPECT_TRUE(IsRowEmpty(empty_row.data(), number_words));
+    EXPECT_FALSE(IsRowFull(empty_row.data(), number_words, last_word_mask));
+}
+
+TEST_P(RowScanTest, RowWithOneOccupiedCellIsNotEmpty) {
+    for (int word{0}; word < number_words; ++word) {
+        std::vector<RowBitsType> row{empty_row};
+        row.at(word) = RowBitsType{1} << 63;
+        EXPECT_FALSE(IsRowEmpty(row.data(), number_words));
+    }
+}
+
+TEST_P(RowScanTest, SingleWordRow) {
+    RowBitsType word{last_word_mask};
+    EXPECT_TRUE(IsRowFull(&word, 1, last_word_mask));
+    word = 0;
+    EXPECT_TRUE(IsRowEmpty(&word, 1));
+}
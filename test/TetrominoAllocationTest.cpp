@@ -0,0 +1,99 @@
+#include <cstdlib>
+#include <new>
+
+#include "../src/GridLogic.h"
+#include "../src/Tetromino.h"
+#include "gtest/gtest.h"
+
+// The global allocation functions are replaced for this test executable such
+// that every heap allocation can be counted.
+namespace {
+std::size_t number_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++number_allocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+class TetrominoAllocationTest : public ::testing::Test {
+   protected:
+    TetrominoAllocationTest() : grid_logic{20, 10}, unit{grid_logic} {
+        grid_logic.RequestSpaceOnGrid(unit.GetPosition(), unit.GetPosition());
+    }
+
+    GridLogic grid_logic;
+    ShapeT unit;
+};
+
+TEST_F(TetrominoAllocationTest, MoveOneStepDoesNotAllocate) {
+    std::size_t allocations_before{number_allocations};
+    bool is_right_move_succeed{unit.MoveOneStep(Direction::right)};
+    bool is_down_move_succeed{unit.MoveOneStep(Direction::down)};
+    bool is_left_move_succeed{unit.MoveOneStep(Direction::left)};
+    std::size_t allocations_after{number_allocations};
+
+    EXPECT_TRUE(is_right_move_succeed);
+    EXPECT_TRUE(is_down_move_succeed);
+    EXPECT_TRUE(is_left_move_succeed);
+    EXPECT_EQ(allocations_before, allocations_after);
+}
+
+TEST_F(TetrominoAllocationTest, RotateDoesNotAllocate) {
+    unit.MoveOneStep(Direction::down);
+    std::size_t allocations_before{number_allocations};
+    unit.Rotate();
+    std::size_t allocations_after{number_allocations};
+
+    EXPECT_EQ(Orientation::east, unit.GetOrientation());
+    EXPECT_EQ(allocations_before, allocations_after);
+}
+
+TEST_F(TetrominoAllocationTest, DropDoesNotAllocate) {
+    std::size_t allocations_before{number_allocations};
+    int drop_distance{grid_logic.GetDropDistance(unit.GetPosition())};
+    bool is_drop_succeed{unit.Drop(drop_distance)};
+    std::size_t allocations_after{number_allocations};
+
+    EXPECT_TRUE(is_drop_succeed);
+    EXPECT_EQ(allocations_before, allocations_after);
+}
+
+TEST_F(TetrominoAllocationTest, CopyingAndDeletingSquaresDoesNotAllocate) {
+    std::size_t allocations_before{number_allocations};
+    TetrominoPositionType position_copy{unit.GetPosition()};
+    auto iterator_to_square_to_be_deleted =
+        unit.GetIteratorToBeginOfPositionVector();
+    unit.DeleteTetrominoSquare(iterator_to_square_to_be_deleted);
+    std::size_t allocations_after{number_allocations};
+
+    EXPECT_EQ(4, position_copy.size());
+    EXPECT_EQ(3, unit.GetPosition().size());
+    EXPECT_EQ(allocations_before, allocations_after);
+}
+
+TEST(GridTetrominoAllocationTest, MovingOnTheConcreteGridDoesNotAllocate) {
+    GridLogic grid_logic{20, 10};
+    ShapeS unit{grid_logic};
+    grid_logic.RequestSpaceOnGrid(unit.GetPosition(), unit.GetPosition());
+
+    std::size_t allocations_before{number_allocations};
+    bool is_down_move_succeed{unit.MoveOneStep(Direction::down)};
+    unit.Rotate();
+    bool is_drop_succeed{
+        unit.Drop(grid_logic.GetDropDistance(unit.GetPosition()))};
+    std::size_t allocations_after{number_allocations};
+
+    EXPECT_TRUE(is_down_move_succeed);
+    EXPECT_EQ(Orientation::east, unit.GetOrientation());
+    EXPECT_TRUE(is_drop_succeed);
+    EXPECT_FALSE(grid_logic.IsRowEmpty(19));
+    EXPECT_EQ(allocations_before, allocations_after);
+}
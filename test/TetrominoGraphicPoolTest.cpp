@@ -0,0 +1,88 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "../src/TetrominoGraphicPool.h"
+#include "gtest/gtest.h"
+
+class TetrominoGraphicPoolTest : public ::testing::Test {
+   protected:
+    TetrominoGraphicPoolTest()
+        : grid_logic{number_rows, number_columns},
+          grid_graphic{number_rows, number_columns, 0.f, 0.f, 600.f} {};
+    int number_rows{20};
+    int number_columns{10};
+
+    GridLogic grid_logic;
+    GridGraphic grid_graphic;
+    TetrominoGraphicPool unit;
+};
+
+TEST_F(TetrominoGraphicPoolTest, ReleasedTetrominoIsReusedForTheSameShape) {
+    Piece piece{MakeSpawnPiece(TetrominoType::T, number_columns)};
+    std::unique_ptr<TetrominoGraphic> tetromino{
+        unit.Acquire(grid_logic, grid_graphic, piece)};
+    const TetrominoGraphic *created_tetromino{tetromino.get()};
+    unit.Release(std::move(tetromino));
+
+    std::unique_ptr<TetrominoGraphic> other_shape{unit.Acquire(
+        grid_logic, grid_graphic,
+        MakeSpawnPiece(TetrominoType::S, number_columns))};
+    std::unique_ptr<TetrominoGraphic> same_shape{
+        unit.Acquire(grid_logic, grid_graphic, piece)};
+
+    EXPECT_NE(created_tetromino, other_shape.get());
+    EXPECT_EQ(created_tetromino, same_shape.get());
+    EXPECT_EQ(2, unit.GetStatistics().number_created);
+    EXPECT_EQ(1, unit.GetStatistics().number_reused);
+    EXPECT_EQ(2, unit.GetStatistics().number_in_use);
+    EXPECT_EQ(0, unit.GetStatistics().number_free);
+}
+
+TEST_F(TetrominoGraphicPoolTest, ReusedTetrominoIsRespawnedAtThePiece) {
+    Piece spawn_piece{MakeSpawnPiece(TetrominoType::J, number_columns)};
+    std::unique_ptr<TetrominoGraphic> tetromino{
+        unit.Acquire(grid_logic, grid_graphic, spawn_piece)};
+    tetromino->MoveOneStep(Direction::down);
+    tetromino->Rotate();
+    tetromino->Drop(grid_logic.GetDropDistance(*tetromino->GetPiece()));
+    ASSERT_TRUE(tetromino->IsLocked());
+    unit.Release(std::move(tetromino));
+
+    Piece next_piece{spawn_piece.Translated(0, -2)};
+    tetromino = unit.Acquire(grid_logic, grid_graphic, next_piece);
+
+    EXPECT_FALSE(tetromino->IsLocked());
+    EXPECT_EQ(next_piece, tetromino->GetPiece());
+    EXPECT_EQ(next_piece.GetCells(), tetromino->GetPositionInGridLogicFrame());
+}
+
+TEST_F(TetrominoGraphicPoolTest, SteadyStateSpawnsDoNotCreateTetrominoes) {
+    // Keep a queue of three tetrominoes plus an active one alive like the
+    // game does, and cycle through all shapes many times
+    std::vector<std::unique_ptr<TetrominoGraphic>> alive_tetrominoes;
+    auto spawn = [&](int index) {
+        TetrominoType type{
+            static_cast<TetrominoType>(index % kNumberTetrominoTypes)};
+        alive_tetrominoes.push_back(unit.Acquire(
+            grid_logic, grid_graphic, MakeSpawnPiece(type, number_columns)));
+        if (alive_tetrominoes.size() > 4) {
+            unit.Release(std::move(alive_tetrominoes.front()));
+            alive_tetrominoes.erase(alive_tetrominoes.begin());
+        }
+    };
+    for (int index{0}; index < 100; ++index) {
+        spawn(index);
+    }
+    std::size_t number_created_after_warm_up{
+        unit.GetStatistics().number_created};
+
+    for (int index{100}; index < 10000; ++index) {
+        spawn(index);
+    }
+
+    EXPECT_EQ(number_created_after_warm_up,
+              unit.GetStatistics().number_created);
+    EXPECT_EQ(4, unit.GetStatistics().number_in_use);
+    EXPECT_EQ(10000, unit.GetStatistics().number_created +
+                         unit.GetStatistics().number_reused);
+}
@@ -19,12 +19,32 @@ TEST(TetrominoPositionTypeOperatorOverloadingDeathTest,
     EXPECT_DEATH(operand1 + operand2, "");
 }
 
+TEST(TetrominoPositionType, NoSuccessWhileExceedingFourSquares) {
+    TetrominoPositionType position{{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    EXPECT_EQ(position.capacity(), position.size());
+    EXPECT_THROW(position.push_back({9, 10}), std::length_error);
+    EXPECT_EQ(position.capacity(), position.size());
+    EXPECT_THROW(
+        (TetrominoPositionType{{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}}),
+        std::length_error);
+}
+
+TEST(TetrominoPositionType, EraseKeepsTheOrderOfTheRemainingSquares) {
+    TetrominoPositionType position{{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    TetrominoPositionType expected_position{{1, 2}, {5, 6}, {7, 8}};
+    auto iterator_following_erased_square =
+        position.erase(position.begin() + 1);
+    EXPECT_EQ(expected_position, position);
+    EXPECT_EQ(position.begin() + 1, iterator_following_erased_square);
+    EXPECT_THROW(position.at(3), std::out_of_range);
+}
+
 class GridLogicMock : public IGridLogic {
    public:
     GridLogicMock() : IGridLogic(){};
     MOCK_METHOD(bool, RequestSpaceOnGrid,
-                (TetrominoPositionType current_position,
-                 TetrominoPositionType target_position),
+                (const TetrominoPositionType& current_position,
+                 const TetrominoPositionType& target_position),
                 (override));
 };
 
@@ -187,6 +207,35 @@ TEST_F(TetrominoTest, MoveDownPossibleBecauseOfUnlocking) {
     EXPECT_EQ(result.expected_targed_position, actual_position);
 }
 
+TEST_F(TetrominoTest, DropPossible) {
+    TetrominoPositionType expected_target_position{
+        {5, 0}, {5, 1}, {5, 2}, {5, 3}};
+    EXPECT_CALL(grid_logic_mock,
+                RequestSpaceOnGrid(init_position, expected_target_position))
+        .Times(1)
+        .WillOnce(::testing::Return(kTargetPositionFree));
+    EXPECT_TRUE(unit.Drop(5));
+    EXPECT_EQ(expected_target_position, unit.GetPosition());
+    EXPECT_TRUE(unit.IsLocked());
+}
+
+TEST_F(TetrominoTest, DropImpossibleBecauseOfOccupiedTargetRegion) {
+    EXPECT_CALL(grid_logic_mock, RequestSpaceOnGrid(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Return(kTargetPositionOccupied));
+    EXPECT_FALSE(unit.Drop(5));
+    EXPECT_EQ(init_position, unit.GetPosition());
+    EXPECT_TRUE(unit.IsLocked());
+}
+
+TEST_F(TetrominoTest, DropImpossibleBecauseOfLockDown) {
+    unit.LockDown();
+    EXPECT_CALL(grid_logic_mock, RequestSpaceOnGrid(::testing::_, ::testing::_))
+        .Times(0);
+    EXPECT_FALSE(unit.Drop(5));
+    EXPECT_EQ(init_position, unit.GetPosition());
+}
+
 TEST_F(TetrominoTest, DeleteFirstSquareElement) {
     TetrominoPositionType expected_pos_after_deletion{{0, 1}, {0, 2}, {0, 3}};
     auto iterator_to_square_to_be_deleted =
@@ -223,6 +272,145 @@ TEST_F(TetrominoTest, DeleteForthSquareElement) {
     EXPECT_EQ(expected_pos_after_deletion, actual_position_after_deletion);
 }
 
+static_assert(GetRotationDeltas(TetrominoType::I, Orientation::north)[0] ==
+                  std::pair<int, int>{-2, 2},
+              "rotation deltas are available at compile time");
+
+TEST(TetrominoRotationDeltas, FourRotationsReturnToTheInitialPosition) {
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        for (int square_idx{0}; square_idx < kNumberSquaresPerTetromino;
+             ++square_idx) {
+            std::pair<int, int> total_delta{0, 0};
+            for (int orientation_idx{0};
+                 orientation_idx < kNumberOrientations; ++orientation_idx) {
+                const auto& delta{GetRotationDeltas(
+                    static_cast<TetrominoType>(type_idx),
+                    static_cast<Orientation>(orientation_idx))[square_idx]};
+                total_delta.first += delta.first;
+                total_delta.second += delta.second;
+            }
+            EXPECT_EQ((std::pair<int, int>{0, 0}), total_delta);
+        }
+    }
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// ----------------- Tests for the Piece ------------------- //
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+static_assert(MakePiece(TetrominoType::T, Orientation::north, 0, 0)
+                      .RotatedClockwise()
+                      .Translated(1, 2) ==
+                  MakePiece(TetrominoType::T, Orientation::east, 1, 2),
+              "pieces can be moved at compile time");
+
+TEST(Piece, BoxMaskMatchesSquareOffsets) {
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        for (int orientation_idx{0}; orientation_idx < kNumberOrientations;
+             ++orientation_idx) {
+            Piece piece{MakePiece(static_cast<TetrominoType>(type_idx),
+                                  static_cast<Orientation>(orientation_idx),
+                                  0, 0)};
+            int number_occupied_box_cells{0};
+            for (int row_offset{0}; row_offset < 4; ++row_offset) {
+                for (int column_offset{0}; column_offset < 4;
+                     ++column_offset) {
+                    if (piece.IsBoxCellOccupied(row_offset, column_offset)) {
+                        ++number_occupied_box_cells;
+                    }
+                }
+            }
+            EXPECT_EQ(kNumberSquaresPerTetromino, number_occupied_box_cells);
+            for (const auto& offset : piece.GetSquareOffsets()) {
+                EXPECT_TRUE(
+                    piece.IsBoxCellOccupied(offset.first, offset.second));
+            }
+        }
+    }
+}
+
+TEST(TetrominoShapeInfos, ShapeTNorth) {
+    const TetrominoShapeInfo& info{
+        GetShapeInfo(TetrominoType::T, Orientation::north)};
+    EXPECT_EQ((std::array<std::uint8_t, 4>{0b010, 0b111, 0, 0}),
+              info.row_masks);
+    EXPECT_EQ(0, info.top_row);
+    EXPECT_EQ(1, info.bottom_row);
+    EXPECT_EQ(0, info.left_column);
+    EXPECT_EQ(2, info.right_column);
+    EXPECT_EQ((std::array<int, 4>{1, 1, 1, -1}), info.lowest_rows);
+    EXPECT_EQ(0, info.spawn_row);
+    EXPECT_EQ(-2, info.spawn_column_offset);
+}
+
+TEST(TetrominoShapeInfos, LowestRowsMatchSquareOffsets) {
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        for (int orientation_idx{0}; orientation_idx < kNumberOrientations;
+             ++orientation_idx) {
+            auto type{static_cast<TetrominoType>(type_idx)};
+            auto orientation{static_cast<Orientation>(orientation_idx)};
+            std::array<int, 4> expected_lowest_rows{-1, -1, -1, -1};
+            for (const auto& offset : GetSquareOffsets(type, orientation)) {
+                expected_lowest_rows[offset.second] = std::max(
+                    expected_lowest_rows[offset.second], offset.first);
+            }
+            EXPECT_EQ(expected_lowest_rows,
+                      GetShapeInfo(type, orientation).lowest_rows);
+        }
+    }
+}
+
+TEST(Piece, SpawnPiecesOnStandardGrid) {
+    EXPECT_EQ((TetrominoPositionType{{0, 3}, {0, 4}, {0, 5}, {0, 6}}),
+              MakeSpawnPiece(TetrominoType::I, 10).GetCells());
+    EXPECT_EQ((TetrominoPositionType{{0, 3}, {1, 3}, {1, 4}, {1, 5}}),
+              MakeSpawnPiece(TetrominoType::J, 10).GetCells());
+    EXPECT_EQ((TetrominoPositionType{{0, 4}, {0, 5}, {1, 5}, {1, 4}}),
+              MakeSpawnPiece(TetrominoType::O, 10).GetCells());
+    EXPECT_EQ((TetrominoPositionType{{0, 3}, {0, 4}, {1, 4}, {1, 5}}),
+              MakeSpawnPiece(TetrominoType::Z, 10).GetCells());
+    EXPECT_EQ(MakePiece(TetrominoType::T, Orientation::north, 0, 63),
+              MakeSpawnPiece(TetrominoType::T, 130));
+}
+
+TEST(Piece, ShapeCreatedFromPieceRotatesLikeThePiece) {
+    ::testing::NiceMock<GridLogicMock> grid_logic_mock;
+    ON_CALL(grid_logic_mock, RequestSpaceOnGrid(::testing::_, ::testing::_))
+        .WillByDefault(::testing::Return(true));
+    for (int type_idx{0}; type_idx < kNumberTetrominoTypes; ++type_idx) {
+        Piece piece{MakeSpawnPiece(static_cast<TetrominoType>(type_idx), 10)};
+        auto shape = MakeTetromino(grid_logic_mock, piece);
+        EXPECT_EQ(piece.type, shape->GetTetrominoType());
+        for (int orientation_idx{0}; orientation_idx < kNumberOrientations;
+             ++orientation_idx) {
+            EXPECT_EQ(piece.GetCells(), shape->GetPosition());
+            piece = piece.RotatedClockwise();
+            shape->Rotate();
+        }
+    }
+}
+
+TEST(Piece, PieceOfAShapeFollowsItsMovements) {
+    ::testing::NiceMock<GridLogicMock> grid_logic_mock;
+    ON_CALL(grid_logic_mock, RequestSpaceOnGrid(::testing::_, ::testing::_))
+        .WillByDefault(::testing::Return(true));
+    Piece piece{MakeSpawnPiece(TetrominoType::L, 10)};
+    auto shape = MakeTetromino(grid_logic_mock, piece);
+    EXPECT_EQ(piece, shape->GetPiece());
+
+    shape->MoveOneStep(Direction::down);
+    shape->Rotate();
+    EXPECT_EQ(piece.Translated(1, 0).RotatedClockwise(), shape->GetPiece());
+
+    auto iterator_to_square_to_be_deleted =
+        shape->GetIteratorToBeginOfPositionVector();
+    shape->DeleteTetrominoSquare(iterator_to_square_to_be_deleted);
+    EXPECT_FALSE(shape->GetPiece());
+}
+
+TEST_F(TetrominoTest, BaseTetrominoHasNoPiece) {
+    EXPECT_FALSE(unit.GetPiece());
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
 // --------------- Tests for the I-Shape ------------------- //
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
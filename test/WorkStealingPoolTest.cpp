@@ -0,0 +1,63 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../src/WorkStealingPool.h"
+#include "gtest/gtest.h"
+
+TEST(WorkStealingPoolTest, EveryTaskRunsExactlyOnce) {
+    WorkStealingPool unit{4};
+    std::vector<std::atomic<int>> number_runs(1001);
+
+    unit.Run(number_runs.size(),
+             [&number_runs](std::size_t task_index, int /*worker_index*/) {
+                 number_runs[task_index].fetch_add(1);
+             });
+
+    for (const auto &number_task_runs : number_runs) {
+        EXPECT_EQ(1, number_task_runs.load());
+    }
+}
+
+TEST(WorkStealingPoolTest, ConsecutiveBatchesReuseTheWorkers) {
+    WorkStealingPool unit{3};
+    std::atomic<long> sum{0};
+
+    for (int batch{0}; batch < 100; ++batch) {
+        unit.Run(batch, [&sum](std::size_t task_index, int /*worker_index*/) {
+            sum += static_cast<long>(task_index);
+        });
+    }
+
+    // every batch adds up 0 + 1 + ... + batch - 1
+    long expected_sum{0};
+    for (long batch{0}; batch < 100; ++batch) {
+        expected_sum += batch * (batch - 1) / 2;
+    }
+    EXPECT_EQ(expected_sum, sum.load());
+    EXPECT_EQ(3, unit.GetNumberOfThreads());
+}
+
+TEST(WorkStealingPoolTest, IdleWorkersStealTasksOfBusyWorker) {
+    // all slow tasks are handed to the first worker up front, the other
+    // workers only get them by stealing
+    WorkStealingPool unit{4};
+    std::vector<int> worker_indexes(8, -1);
+
+    unit.Run(worker_indexes.size() * 4,
+             [&worker_indexes](std::size_t task_index, int worker_index) {
+                 if (task_index < worker_indexes.size()) {
+                     std::this_thread::sleep_for(
+                         std::chrono::milliseconds(20));
+                     worker_indexes[task_index] = worker_index;
+                 }
+             });
+
+    int number_stolen_tasks{0};
+    for (int worker_index : worker_indexes) {
+        ASSERT_NE(-1, worker_index);
+        number_stolen_tasks += worker_index != 0 ? 1 : 0;
+    }
+    EXPECT_LT(0, number_stolen_tasks);
+}
@@ -38,3 +38,72 @@ echo =======================================
 echo
 ./test/GridGraphicTest
 
+echo
+echo =======================================
+echo Run RowScanTest ... 
+echo =======================================
+echo
+./test/RowScanTest
+
+echo
+echo =======================================
+echo Run TetrominoAllocationTest ... 
+echo =======================================
+echo
+./test/TetrominoAllocationTest
+
+echo
+echo =======================================
+echo Run TetrominoGraphicPoolTest ... 
+echo =======================================
+echo
+./test/TetrominoGraphicPoolTest
+
+echo
+echo =======================================
+echo Run GameCoreTest ... 
+echo =======================================
+echo
+./test/GameCoreTest
+
+echo
+echo =======================================
+echo Run PieceRandomizerTest ... 
+echo =======================================
+echo
+./test/PieceRandomizerTest
+
+echo
+echo =======================================
+echo Run WorkStealingPoolTest ... 
+echo =======================================
+echo
+./test/WorkStealingPoolTest
+
+echo
+echo =======================================
+echo Run BatchSimulatorTest ... 
+echo =======================================
+echo
+./test/BatchSimulatorTest
+
+echo
+echo =======================================
+echo Run ReplayTest ... 
+echo =======================================
+echo
+./test/ReplayTest
+
+echo
+echo =======================================
+echo Run GameEventRingTest ... 
+echo =======================================
+echo
+./test/GameEventRingTest
+
+echo
+echo =======================================
+echo Run PieceQueueTest ... 
+echo =======================================
+echo
+./test/PieceQueueTest